@@ -0,0 +1,720 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AssetFootprintAnalyzer.h"
+#include "ToolsAssetRegistryCache.h"
+#include "ToolsStats.h"
+#include "Engine/AssetManager.h"
+#include "Engine/World.h"
+#include "Engine/DataAsset.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "Engine/SCS_Node.h"
+#include "Engine/InheritableComponentHandler.h"
+#include "UObject/UnrealType.h"
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "JsonObjectConverter.h"
+
+namespace AssetFootprintPrivate
+{
+    /** Bytes per texel of the desktop format each compression setting ends up as */
+    float GetBytesPerTexel(const FString& CompressionSettings, bool bHasAlpha)
+    {
+        if (CompressionSettings == TEXT("TC_HDR"))
+        {
+            return 8.0f;
+        }
+        if (CompressionSettings == TEXT("TC_VectorDisplacementmap") || CompressionSettings == TEXT("TC_EditorIcon"))
+        {
+            return 4.0f;
+        }
+        if (CompressionSettings == TEXT("TC_HalfFloat"))
+        {
+            return 2.0f;
+        }
+        if (CompressionSettings == TEXT("TC_Alpha"))
+        {
+            return 0.5f;
+        }
+        if (CompressionSettings.IsEmpty() || CompressionSettings == TEXT("TC_Default") || CompressionSettings == TEXT("TC_Masks"))
+        {
+            // DXT5 with alpha, DXT1 without
+            return bHasAlpha ? 1.0f : 0.5f;
+        }
+
+        // Normal maps (BC5), grayscale (G8), BC6H and BC7 are all one byte per texel
+        return 1.0f;
+    }
+
+    /** Memory of the loaded asset from its registry tags, INDEX_NONE if the class has no estimate */
+    int64 EstimateAssetMemory(const FAssetData& Asset)
+    {
+        const FName ClassName = Asset.AssetClassPath.GetAssetName();
+
+        if (ClassName == TEXT("Texture2D") || ClassName == TEXT("TextureCube"))
+        {
+            FString Dimensions;
+            FString Width;
+            FString Height;
+            if (!Asset.GetTagValue(TEXT("Dimensions"), Dimensions) || !Dimensions.Split(TEXT("x"), &Width, &Height))
+            {
+                return INDEX_NONE;
+            }
+
+            FString CompressionSettings;
+            FString HasAlpha;
+            Asset.GetTagValue(TEXT("CompressionSettings"), CompressionSettings);
+            Asset.GetTagValue(TEXT("HasAlphaChannel"), HasAlpha);
+
+            // Full mip chain is a third more than the top mip
+            const double Texels = double(FCString::Atoi64(*Width)) * FCString::Atoi64(*Height) * (ClassName == TEXT("TextureCube") ? 6 : 1);
+            return int64(Texels * GetBytesPerTexel(CompressionSettings, HasAlpha.ToBool()) * 4.0 / 3.0);
+        }
+
+        if (ClassName == TEXT("StaticMesh") || ClassName == TEXT("SkeletalMesh"))
+        {
+            int64 Vertices = 0;
+            int64 Triangles = 0;
+            int32 LODs = 1;
+            if (!Asset.GetTagValue(TEXT("Vertices"), Vertices) || !Asset.GetTagValue(TEXT("Triangles"), Triangles))
+            {
+                return INDEX_NONE;
+            }
+            Asset.GetTagValue(TEXT("LODs"), LODs);
+
+            // Position, packed tangents and two UVs, plus skin weights for skeletal meshes; 32-bit indices.
+            // Reduced LODs roughly add half of LOD0.
+            const int64 VertexBytes = ClassName == TEXT("SkeletalMesh") ? 48 : 32;
+            const double LODScale = LODs > 1 ? 1.5 : 1.0;
+            return int64((Vertices * VertexBytes + Triangles * 3 * 4) * LODScale);
+        }
+
+        return INDEX_NONE;
+    }
+
+    /** Main asset of the package, the first one for packages without a main asset */
+    const FAssetData* FindMainAsset(const TArray<FAssetData>& Assets)
+    {
+        const FAssetData* MainAsset = Assets.FindByPredicate([](const FAssetData& Asset)
+        {
+            return Asset.IsUAsset();
+        });
+        return MainAsset ? MainAsset : (Assets.Num() > 0 ? &Assets[0] : nullptr);
+    }
+
+    /** Blueprints and data assets are loaded, inspected and released this many at a time */
+    constexpr int32 AuditBatchSize = 32;
+
+    /** One hard reference found on a loaded asset, before its savings are known */
+    struct FPendingReference
+    {
+        FHardReferenceFinding Finding;
+        FName OwnerPackage;
+        FName TargetPackage;
+        FString PropertyClassName;
+    };
+
+    /** Adds every package reachable through hard dependencies from the seeds to Visited */
+    void CollectClosure(const TArray<FName>& Seeds, TSet<FName>& Visited)
+    {
+        FToolsAssetRegistryCache& RegistryCache = FToolsAssetRegistryCache::Get();
+
+        TArray<FName> Pending;
+        for (const FName& Seed : Seeds)
+        {
+            bool bAlreadyVisited = false;
+            Visited.Add(Seed, &bAlreadyVisited);
+            if (!bAlreadyVisited)
+            {
+                Pending.Add(Seed);
+            }
+        }
+
+        while (Pending.Num() > 0)
+        {
+            for (const FName& Dependency : RegistryCache.GetHardDependencies(Pending.Pop(EAllowShrinking::No)))
+            {
+                bool bAlreadyVisited = false;
+                Visited.Add(Dependency, &bAlreadyVisited);
+                if (!bAlreadyVisited && !FPackageName::IsScriptPackage(Dependency.ToString()))
+                {
+                    Pending.Add(Dependency);
+                }
+            }
+        }
+    }
+
+    /** Hard object references of Object pointing outside its package, values inherited from the parent defaults skipped */
+    void CollectHardReferences(const UObject* Object, const UObject* ParentDefaults, const FAssetData& Owner, const FString& OwnerObject, TArray<FPendingReference>& OutReferences)
+    {
+        const UPackage* OwnerPackage = Object->GetOutermost();
+
+        // Top level properties already ruled out: transient, or same value as the parent defaults
+        TMap<const FProperty*, bool> SkippedProperties;
+        TArray<const FProperty*> PropertyChain;
+        TSet<TPair<const FProperty*, const UObject*>> Reported;
+
+        // Recurses into structs, arrays, sets and maps. Soft, weak and lazy pointers derive from
+        // FObjectPropertyBase, not from FObjectProperty, and are left out.
+        for (FPropertyValueIterator It(FObjectProperty::StaticClass(), Object->GetClass(), Object); It; ++It)
+        {
+            const FObjectProperty* ObjectProperty = CastFieldChecked<FObjectProperty>(It.Key());
+
+            PropertyChain.Reset();
+            It.GetPropertyChain(PropertyChain);
+            const FProperty* TopProperty = PropertyChain.Last();
+
+            bool* bSkipped = SkippedProperties.Find(TopProperty);
+            if (!bSkipped)
+            {
+                bSkipped = &SkippedProperties.Add(TopProperty, TopProperty->HasAnyPropertyFlags(CPF_Transient | CPF_DuplicateTransient)
+                    || (ParentDefaults && ParentDefaults->IsA(TopProperty->GetOwnerClass()) && TopProperty->Identical_InContainer(Object, ParentDefaults)));
+            }
+
+            if (*bSkipped || PropertyChain.ContainsByPredicate([](const FProperty* Property) { return Property->HasAnyPropertyFlags(CPF_Transient | CPF_DuplicateTransient); }))
+            {
+                continue;
+            }
+
+            const UObject* Target = ObjectProperty->GetObjectPropertyValue(It.Value());
+            const UPackage* TargetPackage = Target ? Target->GetOutermost() : nullptr;
+            if (!TargetPackage || TargetPackage == OwnerPackage || TargetPackage->HasAnyPackageFlags(PKG_CompiledIn))
+            {
+                continue;
+            }
+
+            // One finding per property and target, an array full of the same mesh is one reference
+            bool bAlreadyReported = false;
+            Reported.Add(TPair<const FProperty*, const UObject*>(TopProperty, Target), &bAlreadyReported);
+            if (bAlreadyReported)
+            {
+                continue;
+            }
+
+            // Struct members by name, container elements (inner, key, value) share the container's
+            FString PropertyPath = TopProperty->GetOwnerClass()->GetName();
+            for (int32 Index = PropertyChain.Num() - 1; Index >= 0; --Index)
+            {
+                if (!PropertyChain[Index]->GetOwner<FProperty>())
+                {
+                    PropertyPath += TEXT(".") + PropertyChain[Index]->GetName();
+                }
+            }
+
+            FPendingReference& Reference = OutReferences.AddDefaulted_GetRef();
+            Reference.OwnerPackage = Owner.PackageName;
+            Reference.TargetPackage = TargetPackage->GetFName();
+            Reference.PropertyClassName = FString(ObjectProperty->PropertyClass->GetPrefixCPP()) + ObjectProperty->PropertyClass->GetName();
+
+            FHardReferenceFinding& Finding = Reference.Finding;
+            Finding.OwnerAsset = Owner.GetObjectPathString();
+            Finding.OwnerObject = OwnerObject;
+            Finding.Property = PropertyPath;
+            Finding.bNativeProperty = TopProperty->GetOwnerClass()->HasAnyClassFlags(CLASS_Native);
+            Finding.TargetAsset = Target->GetPathName();
+            Finding.TargetClass = Target->GetClass()->GetName();
+        }
+    }
+
+    FAssetFootprintReport BuildReport(FName RootPackage, const FString& RootType, int32 MaxChains)
+    {
+        FToolsAssetRegistryCache& RegistryCache = FToolsAssetRegistryCache::Get();
+
+        FAssetFootprintReport Report;
+        Report.RootPackage = RootPackage.ToString();
+        Report.RootType = RootType;
+
+        TArray<FName> Packages;
+        TArray<int32> Parents;
+        UAssetFootprintAnalyzer::CollectHardClosure(RootPackage, Packages, Parents);
+
+        const int32 NumPackages = Packages.Num();
+        TArray<int64> SubtreeDisk;
+        TArray<int64> SubtreeMemory;
+        TArray<int32> SubtreeCount;
+        SubtreeDisk.SetNumZeroed(NumPackages);
+        SubtreeMemory.SetNumZeroed(NumPackages);
+        SubtreeCount.SetNumZeroed(NumPackages);
+
+        TMap<FString, FAssetFootprintClassSize> ByClass;
+        for (int32 Index = 0; Index < NumPackages; ++Index)
+        {
+            FToolsAssetRegistryCache::FAssetList Assets = RegistryCache.GetAssetsByPackageName(Packages[Index]);
+            const FAssetData* MainAsset = FindMainAsset(*Assets);
+
+            const int64 DiskBytes = RegistryCache.GetPackageDiskSize(Packages[Index]);
+            const int64 MemoryBytes = UAssetFootprintAnalyzer::EstimatePackageMemory(Packages[Index]);
+
+            const FString ClassName = MainAsset ? MainAsset->AssetClassPath.GetAssetName().ToString() : TEXT("Unknown");
+            FAssetFootprintClassSize& ClassSize = ByClass.FindOrAdd(ClassName);
+            ClassSize.ClassName = ClassName;
+            ++ClassSize.NumPackages;
+            ClassSize.DiskBytes += DiskBytes;
+            ClassSize.EstimatedMemoryBytes += MemoryBytes;
+
+            SubtreeDisk[Index] = DiskBytes;
+            SubtreeMemory[Index] = MemoryBytes;
+            SubtreeCount[Index] = 1;
+        }
+
+        // Breadth-first order puts every package after its parent, accumulate subtrees bottom up
+        TArray<TArray<int32>> Children;
+        Children.SetNum(NumPackages);
+        for (int32 Index = NumPackages - 1; Index > 0; --Index)
+        {
+            const int32 Parent = Parents[Index];
+            SubtreeDisk[Parent] += SubtreeDisk[Index];
+            SubtreeMemory[Parent] += SubtreeMemory[Index];
+            SubtreeCount[Parent] += SubtreeCount[Index];
+            Children[Parent].Add(Index);
+        }
+
+        Report.NumPackages = NumPackages;
+        Report.DiskBytes = NumPackages > 0 ? SubtreeDisk[0] : 0;
+        Report.EstimatedMemoryBytes = NumPackages > 0 ? SubtreeMemory[0] : 0;
+
+        ByClass.GenerateValueArray(Report.ByClass);
+        Report.ByClass.Sort([](const FAssetFootprintClassSize& A, const FAssetFootprintClassSize& B)
+        {
+            return A.EstimatedMemoryBytes > B.EstimatedMemoryBytes;
+        });
+
+        if (NumPackages == 0)
+        {
+            return Report;
+        }
+
+        auto ByMemory = [&SubtreeMemory](int32 A, int32 B)
+        {
+            return SubtreeMemory[A] > SubtreeMemory[B];
+        };
+
+        TArray<int32> DirectDependencies = Children[0];
+        DirectDependencies.Sort(ByMemory);
+
+        for (int32 ChainIndex = 0; ChainIndex < FMath::Min(MaxChains, DirectDependencies.Num()); ++ChainIndex)
+        {
+            const int32 First = DirectDependencies[ChainIndex];
+
+            FAssetFootprintChain& Chain = Report.HeaviestChains.AddDefaulted_GetRef();
+            Chain.NumPackages = SubtreeCount[First];
+            Chain.DiskBytes = SubtreeDisk[First];
+            Chain.EstimatedMemoryBytes = SubtreeMemory[First];
+
+            // Follow the branch while a single child carries at least half of what is left
+            int32 Current = First;
+            while (Current != INDEX_NONE)
+            {
+                Chain.Packages.Add(Packages[Current].ToString());
+
+                int32 Heaviest = INDEX_NONE;
+                for (int32 Child : Children[Current])
+                {
+                    if (Heaviest == INDEX_NONE || ByMemory(Child, Heaviest))
+                    {
+                        Heaviest = Child;
+                    }
+                }
+
+                Current = Heaviest != INDEX_NONE && SubtreeMemory[Heaviest] * 2 >= SubtreeMemory[Current] ? Heaviest : INDEX_NONE;
+            }
+        }
+
+        return Report;
+    }
+}
+
+int64 UAssetFootprintAnalyzer::EstimatePackageMemory(FName PackageName)
+{
+    FToolsAssetRegistryCache& RegistryCache = FToolsAssetRegistryCache::Get();
+
+    FToolsAssetRegistryCache::FAssetList Assets = RegistryCache.GetAssetsByPackageName(PackageName);
+    const FAssetData* MainAsset = AssetFootprintPrivate::FindMainAsset(*Assets);
+    const int64 Estimate = MainAsset ? AssetFootprintPrivate::EstimateAssetMemory(*MainAsset) : INDEX_NONE;
+
+    // Other classes keep roughly their serialized size in memory
+    return Estimate != INDEX_NONE ? Estimate : RegistryCache.GetPackageDiskSize(PackageName);
+}
+
+void UAssetFootprintAnalyzer::CollectHardClosure(FName PackageName, TArray<FName>& OutPackages, TArray<int32>& OutParents)
+{
+    FToolsAssetRegistryCache& RegistryCache = FToolsAssetRegistryCache::Get();
+
+    OutPackages.Reset();
+    OutParents.Reset();
+
+    TSet<FName> Visited;
+    Visited.Add(PackageName);
+    OutPackages.Add(PackageName);
+    OutParents.Add(INDEX_NONE);
+
+    for (int32 Index = 0; Index < OutPackages.Num(); ++Index)
+    {
+        for (const FName& Dependency : RegistryCache.GetHardDependencies(OutPackages[Index]))
+        {
+            // Native packages are always loaded and cost nothing on disk
+            if (FPackageName::IsScriptPackage(Dependency.ToString()))
+            {
+                continue;
+            }
+
+            bool bAlreadyVisited = false;
+            Visited.Add(Dependency, &bAlreadyVisited);
+            if (!bAlreadyVisited)
+            {
+                OutPackages.Add(Dependency);
+                OutParents.Add(Index);
+            }
+        }
+    }
+}
+
+TArray<FAssetFootprintReport> UAssetFootprintAnalyzer::AnalyzeLoadFootprints(int32 MaxChains)
+{
+    TOOLS_OPERATION_SCOPE("AnalyzeLoadFootprints");
+
+    // Maps first, then primary assets that are not maps
+    TArray<TPair<FName, FString>> Roots;
+    TSet<FName> RootPackages;
+
+    ToolsOperationProfile.BeginPhase(TEXT("Registry Query"));
+    {
+        FARFilter Filter;
+        Filter.bRecursivePaths = true;
+        Filter.PackagePaths.Add(FName("/Game"));
+        Filter.ClassPaths.Add(UWorld::StaticClass()->GetClassPathName());
+
+        for (const FAssetData& Map : *FToolsAssetRegistryCache::Get().GetAssets(Filter))
+        {
+            RootPackages.Add(Map.PackageName);
+            Roots.Emplace(Map.PackageName, TEXT("Map"));
+        }
+    }
+
+    if (UAssetManager* AssetManager = UAssetManager::GetIfInitialized())
+    {
+        TArray<FPrimaryAssetTypeInfo> TypeInfos;
+        AssetManager->GetPrimaryAssetTypeInfoList(TypeInfos);
+
+        for (const FPrimaryAssetTypeInfo& TypeInfo : TypeInfos)
+        {
+            TArray<FPrimaryAssetId> AssetIds;
+            AssetManager->GetPrimaryAssetIdList(TypeInfo.PrimaryAssetType, AssetIds);
+
+            for (const FPrimaryAssetId& AssetId : AssetIds)
+            {
+                const FName PackageName = AssetManager->GetPrimaryAssetPath(AssetId).GetLongPackageFName();
+                bool bAlreadyAdded = false;
+                RootPackages.Add(PackageName, &bAlreadyAdded);
+                if (!PackageName.IsNone() && !bAlreadyAdded)
+                {
+                    Roots.Emplace(PackageName, TypeInfo.PrimaryAssetType.ToString());
+                }
+            }
+        }
+    }
+    ToolsOperationProfile.EndPhase();
+
+    // The registry cache is thread safe, each root walks its closure on its own worker
+    TArray<FAssetFootprintReport> Reports;
+    Reports.SetNum(Roots.Num());
+    {
+        TOOLS_PHASE_SCOPE("Walk Dependencies", STAT_Tools_Analysis);
+        ParallelFor(Roots.Num(), [&Reports, &Roots, MaxChains](int32 Index)
+        {
+            Reports[Index] = AssetFootprintPrivate::BuildReport(Roots[Index].Key, Roots[Index].Value, MaxChains);
+        });
+    }
+
+    int64 PackagesVisited = 0;
+    for (const FAssetFootprintReport& Report : Reports)
+    {
+        PackagesVisited += Report.NumPackages;
+    }
+    FToolsOperationProfile::CountAssetsScanned(PackagesVisited);
+
+    Reports.Sort([](const FAssetFootprintReport& A, const FAssetFootprintReport& B)
+    {
+        return A.EstimatedMemoryBytes > B.EstimatedMemoryBytes;
+    });
+
+    UE_LOG(LogTemp, Log, TEXT("AnalyzeLoadFootprints: Analyzed %d roots, %lld packages visited"), Reports.Num(), PackagesVisited);
+    return Reports;
+}
+
+FAssetFootprintReport UAssetFootprintAnalyzer::AnalyzePackageFootprint(const FString& PackageName, int32 MaxChains)
+{
+    TOOLS_OPERATION_SCOPE("AnalyzePackageFootprint");
+
+    FAssetFootprintReport Report = AssetFootprintPrivate::BuildReport(FName(*PackageName), TEXT("Package"), MaxChains);
+    FToolsOperationProfile::CountAssetsScanned(Report.NumPackages);
+    return Report;
+}
+
+TArray<FHardReferenceFinding> UAssetFootprintAnalyzer::AuditHardReferences(const FString& Folder, int64 MinTargetBytes)
+{
+    using namespace AssetFootprintPrivate;
+
+    TOOLS_OPERATION_SCOPE("AuditHardReferences");
+
+    FARFilter Filter;
+    Filter.bRecursivePaths = true;
+    Filter.bRecursiveClasses = true;
+    Filter.PackagePaths.Add(FName(*Folder));
+    Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+    Filter.ClassPaths.Add(UDataAsset::StaticClass()->GetClassPathName());
+
+    ToolsOperationProfile.BeginPhase(TEXT("Registry Query"));
+    FToolsAssetRegistryCache::FAssetList Assets = FToolsAssetRegistryCache::Get().GetAssets(Filter);
+    ToolsOperationProfile.EndPhase();
+    FToolsOperationProfile::CountAssetsScanned(Assets->Num());
+
+    // Property values need the objects, read them on the game thread in batches
+    TArray<FPendingReference> References;
+    for (int32 BatchStart = 0; BatchStart < Assets->Num(); BatchStart += AuditBatchSize)
+    {
+        const int32 BatchEnd = FMath::Min(BatchStart + AuditBatchSize, Assets->Num());
+        {
+            TOOLS_PHASE_SCOPE("Collect References", STAT_Tools_Load);
+            for (int32 Index = BatchStart; Index < BatchEnd; ++Index)
+            {
+                const FAssetData& Owner = (*Assets)[Index];
+                UObject* Asset = Owner.GetAsset();
+
+                if (const UBlueprint* Blueprint = Cast<UBlueprint>(Asset))
+                {
+                    UBlueprintGeneratedClass* Class = Cast<UBlueprintGeneratedClass>(Blueprint->GeneratedClass);
+                    if (!Class)
+                    {
+                        continue;
+                    }
+
+                    const UObject* ParentDefaults = Class->GetSuperClass() ? Class->GetSuperClass()->GetDefaultObject() : nullptr;
+                    CollectHardReferences(Class->GetDefaultObject(), ParentDefaults, Owner, TEXT("Defaults"), References);
+
+                    // Components added in this Blueprint, the parent Blueprint reports its own
+                    if (Class->SimpleConstructionScript)
+                    {
+                        for (const USCS_Node* Node : Class->SimpleConstructionScript->GetAllNodes())
+                        {
+                            if (Node && Node->ComponentTemplate)
+                            {
+                                CollectHardReferences(Node->ComponentTemplate, Node->ComponentTemplate->GetClass()->GetDefaultObject(), Owner, Node->GetVariableName().ToString(), References);
+                            }
+                        }
+                    }
+
+                    // Overrides of components inherited from a parent Blueprint, only the changed values
+                    if (UInheritableComponentHandler* InheritedComponents = Class->GetInheritableComponentHandler())
+                    {
+                        for (auto RecordIt = InheritedComponents->CreateRecordIterator(); RecordIt; ++RecordIt)
+                        {
+                            if (const UActorComponent* Template = RecordIt->ComponentTemplate)
+                            {
+                                const UActorComponent* ParentTemplate = RecordIt->ComponentKey.GetOriginalTemplate();
+                                CollectHardReferences(Template, ParentTemplate ? ParentTemplate : Template->GetClass()->GetDefaultObject(), Owner,
+                                    RecordIt->ComponentKey.GetSCSVariableName().ToString(), References);
+                            }
+                        }
+                    }
+                }
+                else if (Asset)
+                {
+                    CollectHardReferences(Asset, Asset->GetClass()->GetDefaultObject(), Owner, TEXT("Defaults"), References);
+                }
+            }
+        }
+
+        if (IsRunningCommandlet())
+        {
+            TOOLS_PHASE_SCOPE("Garbage Collection", STAT_Tools_Load);
+            CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+        }
+    }
+
+    // Group by owner, the closure without the reference is shared by all its targets
+    TMap<FName, TArray<int32>> ReferencesByOwner;
+    for (int32 Index = 0; Index < References.Num(); ++Index)
+    {
+        ReferencesByOwner.FindOrAdd(References[Index].OwnerPackage).Add(Index);
+    }
+
+    TArray<TPair<FName, TArray<int32>>> Owners = ReferencesByOwner.Array();
+    ToolsOperationProfile.BeginPhase(TEXT("Compute Savings"));
+    ParallelFor(Owners.Num(), [&Owners, &References](int32 OwnerIndex)
+    {
+        FToolsAssetRegistryCache& RegistryCache = FToolsAssetRegistryCache::Get();
+        const FName OwnerPackage = Owners[OwnerIndex].Key;
+        const TArray<int32>& OwnerReferences = Owners[OwnerIndex].Value;
+        const TArray<FName> OwnerDependencies = RegistryCache.GetHardDependencies(OwnerPackage);
+
+        TMap<FName, TPair<int64, int64>> SizesByTarget;
+        for (int32 ReferenceIndex : OwnerReferences)
+        {
+            const FName TargetPackage = References[ReferenceIndex].TargetPackage;
+            if (SizesByTarget.Contains(TargetPackage))
+            {
+                continue;
+            }
+
+            // What the owner still loads once the edge to the target is gone
+            // The owner is marked visited first so its own edge to the target is not followed
+            TArray<FName> OtherSeeds = OwnerDependencies;
+            OtherSeeds.Remove(TargetPackage);
+            TSet<FName> StillLoaded;
+            StillLoaded.Add(OwnerPackage);
+            CollectClosure(OtherSeeds, StillLoaded);
+
+            TArray<FName> TargetClosure;
+            TArray<int32> Parents;
+            CollectHardClosure(TargetPackage, TargetClosure, Parents);
+
+            int64 ClosureBytes = 0;
+            int64 SavingsBytes = 0;
+            for (const FName& Package : TargetClosure)
+            {
+                const int64 PackageBytes = EstimatePackageMemory(Package);
+                ClosureBytes += PackageBytes;
+                SavingsBytes += StillLoaded.Contains(Package) ? 0 : PackageBytes;
+            }
+            SizesByTarget.Add(TargetPackage, TPair<int64, int64>(ClosureBytes, SavingsBytes));
+        }
+
+        for (int32 ReferenceIndex : OwnerReferences)
+        {
+            FPendingReference& Reference = References[ReferenceIndex];
+            const TPair<int64, int64>& Sizes = SizesByTarget.FindChecked(Reference.TargetPackage);
+            Reference.Finding.TargetClosureBytes = Sizes.Key;
+            Reference.Finding.EstimatedSavingsBytes = Sizes.Value;
+            Reference.Finding.OtherReferencesToTarget = OwnerReferences.FilterByPredicate([&References, &Reference](int32 Other)
+            {
+                return References[Other].TargetPackage == Reference.TargetPackage;
+            }).Num() - 1;
+        }
+    });
+    ToolsOperationProfile.EndPhase();
+
+    TArray<FHardReferenceFinding> Findings;
+    for (FPendingReference& Reference : References)
+    {
+        FHardReferenceFinding& Finding = Reference.Finding;
+        if (Finding.TargetClosureBytes < MinTargetBytes)
+        {
+            continue;
+        }
+
+        Finding.Suggestion = Finding.bNativeProperty
+            ? FString::Printf(TEXT("Declare %s as TSoftObjectPtr<%s> (TSoftClassPtr for classes) and load it through the StreamableManager when first needed"), *Finding.Property, *Reference.PropertyClassName)
+            : FString::Printf(TEXT("Change %s to a Soft Object Reference and load it with Async Load Asset when first needed"), *Finding.Property);
+
+        if (Finding.OtherReferencesToTarget > 0)
+        {
+            Finding.Suggestion += FString::Printf(TEXT(", together with the %d other references to %s"), Finding.OtherReferencesToTarget, *Finding.TargetAsset);
+        }
+
+        Findings.Add(MoveTemp(Finding));
+    }
+
+    Findings.Sort([](const FHardReferenceFinding& A, const FHardReferenceFinding& B)
+    {
+        return A.EstimatedSavingsBytes > B.EstimatedSavingsBytes;
+    });
+
+    UE_LOG(LogTemp, Log, TEXT("AuditHardReferences: %d hard references found, %d above %lld bytes"), References.Num(), Findings.Num(), MinTargetBytes);
+    return Findings;
+}
+
+bool UAssetFootprintAnalyzer::ExportHardReferenceAudit(const TArray<FHardReferenceFinding>& Findings, const FString& FilePath)
+{
+    FString Output;
+
+    if (FPaths::GetExtension(FilePath).Equals(TEXT("json"), ESearchCase::IgnoreCase))
+    {
+        TArray<TSharedPtr<FJsonValue>> JsonFindings;
+        for (const FHardReferenceFinding& Finding : Findings)
+        {
+            JsonFindings.Add(MakeShared<FJsonValueObject>(FJsonObjectConverter::UStructToJsonObject(Finding)));
+        }
+
+        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+        if (!FJsonSerializer::Serialize(JsonFindings, Writer))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        Output += TEXT("OwnerAsset,OwnerObject,Property,NativeProperty,TargetAsset,TargetClass,TargetClosureBytes,EstimatedSavingsBytes,OtherReferencesToTarget,Suggestion\n");
+        for (const FHardReferenceFinding& Finding : Findings)
+        {
+            Output += FString::Printf(TEXT("%s,%s,%s,%d,%s,%s,%lld,%lld,%d,\"%s\"\n"),
+                *Finding.OwnerAsset, *Finding.OwnerObject, *Finding.Property, Finding.bNativeProperty, *Finding.TargetAsset, *Finding.TargetClass,
+                Finding.TargetClosureBytes, Finding.EstimatedSavingsBytes, Finding.OtherReferencesToTarget, *Finding.Suggestion.Replace(TEXT("\""), TEXT("\"\"")));
+        }
+    }
+
+    if (!FFileHelper::SaveStringToFile(Output, *FilePath))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ExportHardReferenceAudit: Failed to write %s"), *FilePath);
+        return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("ExportHardReferenceAudit: Wrote %d findings to %s"), Findings.Num(), *FilePath);
+    return true;
+}
+
+bool UAssetFootprintAnalyzer::ExportFootprintReports(const TArray<FAssetFootprintReport>& Reports, const FString& FilePath)
+{
+    FString Output;
+
+    if (FPaths::GetExtension(FilePath).Equals(TEXT("json"), ESearchCase::IgnoreCase))
+    {
+        TArray<TSharedPtr<FJsonValue>> JsonReports;
+        for (const FAssetFootprintReport& Report : Reports)
+        {
+            JsonReports.Add(MakeShared<FJsonValueObject>(FJsonObjectConverter::UStructToJsonObject(Report)));
+        }
+
+        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+        if (!FJsonSerializer::Serialize(JsonReports, Writer))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        Output += TEXT("Root,RootType,Kind,Name,Packages,DiskBytes,EstimatedMemoryBytes\n");
+        for (const FAssetFootprintReport& Report : Reports)
+        {
+            Output += FString::Printf(TEXT("%s,%s,Total,,%d,%lld,%lld\n"),
+                *Report.RootPackage, *Report.RootType, Report.NumPackages, Report.DiskBytes, Report.EstimatedMemoryBytes);
+
+            for (const FAssetFootprintClassSize& ClassSize : Report.ByClass)
+            {
+                Output += FString::Printf(TEXT("%s,%s,Class,%s,%d,%lld,%lld\n"),
+                    *Report.RootPackage, *Report.RootType, *ClassSize.ClassName, ClassSize.NumPackages, ClassSize.DiskBytes, ClassSize.EstimatedMemoryBytes);
+            }
+
+            for (const FAssetFootprintChain& Chain : Report.HeaviestChains)
+            {
+                Output += FString::Printf(TEXT("%s,%s,Chain,\"%s\",%d,%lld,%lld\n"),
+                    *Report.RootPackage, *Report.RootType, *FString::Join(Chain.Packages, TEXT(" > ")), Chain.NumPackages, Chain.DiskBytes, Chain.EstimatedMemoryBytes);
+            }
+        }
+    }
+
+    if (!FFileHelper::SaveStringToFile(Output, *FilePath))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ExportFootprintReports: Failed to write %s"), *FilePath);
+        return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("ExportFootprintReports: Wrote %d reports to %s"), Reports.Num(), *FilePath);
+    return true;
+}
@@ -2,13 +2,18 @@
 
 
 #include "AutoCleanupTool.h"
-#include "AssetRegistry/AssetRegistryModule.h"
+#include "ToolsAssetRegistryCache.h"
 #include "EditorAssetLibrary.h"
 #include "Misc/PackageName.h"
 #include "AssetToolsModule.h"
+#include "ToolsStats.h"
+#include "ToolsJobSubsystem.h"
+#include "HAL/FileManager.h"
 
 TArray<FAssetData> UAutoCleanupTool::FindUnusedAssets(const TArray<FString>& ExcludedFolders)
 {
+    TOOLS_OPERATION_SCOPE("FindUnusedAssets");
+
     TArray<FAssetData> UnusedAssets;
 
     // Prepare a recursive filter scoped to the /Game directory, which contains project content
@@ -16,13 +21,15 @@ TArray<FAssetData> UAutoCleanupTool::FindUnusedAssets(const TArray<FString>& Exc
     Filter.bRecursivePaths = true;
     Filter.PackagePaths.Add(FName("/Game"));
 
-    // Retrieve all assets in /Game using the Asset Registry module
-    TArray<FAssetData> AllAssets;
-    FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-    AssetRegistryModule.Get().GetAssets(Filter, AllAssets);
+    // Retrieve all assets in /Game through the shared registry cache
+    ToolsOperationProfile.BeginPhase(TEXT("Registry Query"));
+    FToolsAssetRegistryCache::FAssetList AllAssets = FToolsAssetRegistryCache::Get().GetAssets(Filter);
+    ToolsOperationProfile.EndPhase();
+    FToolsOperationProfile::CountAssetsScanned(AllAssets->Num());
 
     // Iterate through each asset to determine if it is unused and not in excluded folders
-    for (const FAssetData& Asset : AllAssets)
+    TOOLS_PHASE_SCOPE("Reference Check", STAT_Tools_Analysis);
+    for (const FAssetData& Asset : *AllAssets)
     {
         const FString AssetPath = Asset.PackagePath.ToString();
 
@@ -55,12 +62,8 @@ TArray<FAssetData> UAutoCleanupTool::FindUnusedAssets(const TArray<FString>& Exc
 
 bool UAutoCleanupTool::IsAssetUsed(const FAssetData& AssetData)
 {
-    // Load AssetRegistry for reference checks
-    FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-
-    TArray<FName> Referencers;
-    // Get assets that reference this one
-    AssetRegistryModule.Get().GetReferencers(AssetData.PackageName, Referencers);
+    // Get assets that reference this one, cached and safe from worker threads
+    const TArray<FName> Referencers = FToolsAssetRegistryCache::Get().GetReferencers(AssetData.PackageName);
 
     // If the list is non-empty, the asset is used
     return Referencers.Num() > 0;
@@ -68,7 +71,16 @@ bool UAutoCleanupTool::IsAssetUsed(const FAssetData& AssetData)
 
 FString UAutoCleanupTool::MoveUnusedAssetsToFolder(const FString& NewFolderPath, const TArray<FString>& ExcludedFolders)
 {
+    int32 FailCount = 0;
+    return MoveUnusedAssetsToFolder(NewFolderPath, ExcludedFolders, FailCount);
+}
+
+FString UAutoCleanupTool::MoveUnusedAssetsToFolder(const FString& NewFolderPath, const TArray<FString>& ExcludedFolders, int32& OutFailCount)
+{
+    TOOLS_OPERATION_SCOPE("MoveUnusedAssetsToFolder");
+
     FString Log;
+    OutFailCount = 0;
 
     // Validate that the destination folder is within the /Game directory
     if (!NewFolderPath.StartsWith("/Game"))
@@ -95,39 +107,43 @@ FString UAutoCleanupTool::MoveUnusedAssetsToFolder(const FString& NewFolderPath,
     TArray<FAssetData> UnusedAssets = UAutoCleanupTool::FindUnusedAssets(ExcludedFolders);
 
     int32 SuccessCount = 0;
-    int32 FailCount = 0;
+    int32& FailCount = OutFailCount;
     int64 TotalMovedBytes = 0;
 
     // Iterate through each unused asset and attempt to move it
-    for (const FAssetData& Asset : UnusedAssets)
     {
-        FString OldPath = Asset.ObjectPath.ToString();
-        FString PackageName = Asset.PackageName.ToString();
-        FString AssetName = Asset.AssetName.ToString();
-        FString NewObjectPath = NewFolderPath / AssetName;
-
-        // Try to get the absolute file path of the .uasset
-        FString AssetFilePath;
-        if (FPackageName::TryConvertLongPackageNameToFilename(PackageName, AssetFilePath, TEXT(".uasset")))
+        TOOLS_PHASE_SCOPE("Rename", STAT_Tools_Rename);
+        for (const FAssetData& Asset : UnusedAssets)
         {
-            int64 FileSize = IFileManager::Get().FileSize(*AssetFilePath);
-            if (FileSize > 0)
+            FString OldPath = Asset.ObjectPath.ToString();
+            FString PackageName = Asset.PackageName.ToString();
+            FString AssetName = Asset.AssetName.ToString();
+            FString NewObjectPath = NewFolderPath / AssetName;
+
+            // Try to get the absolute file path of the .uasset
+            FString AssetFilePath;
+            if (FPackageName::TryConvertLongPackageNameToFilename(PackageName, AssetFilePath, TEXT(".uasset")))
             {
-                TotalMovedBytes += FileSize;
+                int64 FileSize = IFileManager::Get().FileSize(*AssetFilePath);
+                if (FileSize > 0)
+                {
+                    TotalMovedBytes += FileSize;
+                    FToolsOperationProfile::CountBytesTouched(FileSize);
+                }
             }
-        }
 
-        // Attempt to move the asset
-        bool bSuccess = UEditorAssetLibrary::RenameAsset(OldPath, NewObjectPath);
+            // Attempt to move the asset
+            bool bSuccess = UEditorAssetLibrary::RenameAsset(OldPath, NewObjectPath);
 
-        if (bSuccess)
-        {
-            ++SuccessCount;
-        }
-        else
-        {
-            ++FailCount;
-            Log += FString::Printf(TEXT("Failed to move asset: %s\n"), *OldPath);
+            if (bSuccess)
+            {
+                ++SuccessCount;
+            }
+            else
+            {
+                ++FailCount;
+                Log += FString::Printf(TEXT("Failed to move asset: %s\n"), *OldPath);
+            }
         }
     }
 
@@ -146,6 +162,123 @@ FString UAutoCleanupTool::MoveUnusedAssetsToFolder(const FString& NewFolderPath,
     return Log;
 }
 
+int32 UAutoCleanupTool::MoveUnusedAssetsToFolderAsync(const FString& NewFolderPath, const TArray<FString>& ExcludedFolders)
+{
+    UToolsJobSubsystem* Jobs = UToolsJobSubsystem::Get();
+    if (!Jobs)
+    {
+        return 0;
+    }
+
+    if (!NewFolderPath.StartsWith("/Game"))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MoveUnusedAssetsToFolderAsync: Invalid folder path %s. It must start with '/Game'."), *NewFolderPath);
+        return 0;
+    }
+
+    struct FCleanupJobData
+    {
+        TArray<FAssetData> Candidates;
+        TArray<FAssetData> UnusedAssets;
+        int32 NextAsset = 0;
+        int32 SuccessCount = 0;
+        int32 FailCount = 0;
+        int64 TotalMovedBytes = 0;
+    };
+
+    TSharedRef<FCleanupJobData> Data = MakeShared<FCleanupJobData>();
+
+    TArray<FToolsJobPhase> Phases;
+
+    // Registry query and folder filtering are cheap, do them in a single slice
+    Phases.Add(FToolsJobPhase::GameThread(TEXT("Registry Query"), [Data, ExcludedFolders](FToolsJobContext& Context)
+    {
+        FARFilter Filter;
+        Filter.bRecursivePaths = true;
+        Filter.PackagePaths.Add(FName("/Game"));
+
+        FToolsAssetRegistryCache::FAssetList AllAssets = FToolsAssetRegistryCache::Get().GetAssets(Filter);
+        for (const FAssetData& Asset : *AllAssets)
+        {
+            const FString AssetPath = Asset.PackagePath.ToString();
+            const bool bIsExcluded = ExcludedFolders.ContainsByPredicate([&AssetPath](const FString& Excluded)
+            {
+                return AssetPath.StartsWith(Excluded);
+            });
+
+            if (!bIsExcluded)
+            {
+                Data->Candidates.Add(Asset);
+            }
+        }
+        return true;
+    }));
+
+    // The registry cache is thread safe, referencer lookups and file sizes run off the game thread
+    Phases.Add(FToolsJobPhase::Worker(TEXT("Reference Check"), [Data](FToolsJobContext& Context)
+    {
+        const int32 Total = Data->Candidates.Num();
+        for (int32 Index = 0; Index < Total; ++Index)
+        {
+            if (Context.IsCancelled())
+            {
+                return;
+            }
+
+            const FAssetData& Asset = Data->Candidates[Index];
+            FString AssetFilePath;
+            if (FPackageName::DoesPackageExist(Asset.PackageName.ToString(), &AssetFilePath) && !IsAssetUsed(Asset))
+            {
+                const int64 FileSize = IFileManager::Get().FileSize(*AssetFilePath);
+                if (FileSize > 0)
+                {
+                    Data->TotalMovedBytes += FileSize;
+                }
+                Data->UnusedAssets.Add(Asset);
+            }
+
+            Context.SetProgress(float(Index + 1) / Total);
+        }
+    }));
+
+    // Renames fix up redirectors and touch packages, one asset per slice
+    Phases.Add(FToolsJobPhase::GameThread(TEXT("Rename"), [Data, NewFolderPath](FToolsJobContext& Context)
+    {
+        if (Data->NextAsset == 0 && !UEditorAssetLibrary::DoesDirectoryExist(NewFolderPath) && !UEditorAssetLibrary::MakeDirectory(NewFolderPath))
+        {
+            Context.Fail(FString::Printf(TEXT("Failed to create folder: %s"), *NewFolderPath));
+            return true;
+        }
+
+        if (!Data->UnusedAssets.IsValidIndex(Data->NextAsset))
+        {
+            return true;
+        }
+
+        const FAssetData& Asset = Data->UnusedAssets[Data->NextAsset++];
+        const FString OldPath = Asset.GetObjectPathString();
+        if (UEditorAssetLibrary::RenameAsset(OldPath, NewFolderPath / Asset.AssetName.ToString()))
+        {
+            ++Data->SuccessCount;
+        }
+        else
+        {
+            ++Data->FailCount;
+            UE_LOG(LogTemp, Warning, TEXT("MoveUnusedAssetsToFolderAsync: Failed to move asset %s"), *OldPath);
+        }
+
+        Context.SetProgress(float(Data->NextAsset) / Data->UnusedAssets.Num());
+        return Data->NextAsset >= Data->UnusedAssets.Num();
+    }));
+
+    return Jobs->SubmitJob(TEXT("Move Unused Assets"), MoveTemp(Phases), TArray<int32>(), [Data, NewFolderPath](EToolsJobState State)
+    {
+        UE_LOG(LogTemp, Log, TEXT("MoveUnusedAssetsToFolderAsync: %s, moved %d of %d unused assets to %s (%.2f MB), %d failed"),
+            *UEnum::GetValueAsString(State), Data->SuccessCount, Data->UnusedAssets.Num(), *NewFolderPath,
+            Data->TotalMovedBytes / (1024.0f * 1024.0f), Data->FailCount);
+    });
+}
+
 TArray<FString> UAutoCleanupTool::GetUnusedAssetNames(const TArray<FString>& ExcludedFolders)
 {
     TArray<FAssetData> UnusedAssets = FindUnusedAssets(ExcludedFolders);
@@ -0,0 +1,295 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ChunkedSaveDataAsset.h"
+#include "USaveDataAsset.h"
+#include "Async/AsyncFileHandle.h"
+#include "Serialization/BulkData.h"
+
+namespace ChunkedSaveDataAssetPrivate
+{
+    int32 ReadInt32(const uint8* Data, int64 Offset)
+    {
+        int32 Value;
+        FMemory::Memcpy(&Value, Data + Offset, sizeof(int32));
+        return Value;
+    }
+}
+
+FString UChunkedSaveDataAsset::GetString(int32 Index)
+{
+    if (Index < 0 || Index >= NumStrings)
+    {
+        return FString();
+    }
+
+    PollPendingReads();
+
+    const int32 PageIndex = Index / StringsPerPage;
+    LoadPage(PageIndex);
+
+    FPage& Page = Pages[PageIndex];
+    const uint8* Data = Page.Payload.GetData();
+    const int32 Count = ChunkedSaveDataAssetPrivate::ReadInt32(Data, 0);
+    const int64 StringsStart = sizeof(int32) * (1 + int64(Count));
+    const int32 Offset = ChunkedSaveDataAssetPrivate::ReadInt32(Data, sizeof(int32) * (1 + int64(Index % StringsPerPage)));
+
+    return FString(UTF8_TO_TCHAR(reinterpret_cast<const ANSICHAR*>(Data + StringsStart + Offset)));
+}
+
+bool UChunkedSaveDataAsset::IsStringResident(int32 Index)
+{
+    if (Index < 0 || Index >= NumStrings)
+    {
+        return false;
+    }
+
+    FPage& Page = Pages[Index / StringsPerPage];
+    if (Page.PendingRequest)
+    {
+        CompletePendingRead(Page, false);
+    }
+    return Page.bResident;
+}
+
+void UChunkedSaveDataAsset::PrefetchStrings(int32 FirstIndex, int32 Count)
+{
+    if (NumStrings == 0 || Count <= 0)
+    {
+        return;
+    }
+
+    PollPendingReads();
+
+    const int32 FirstPage = FMath::Clamp(FirstIndex, 0, NumStrings - 1) / StringsPerPage;
+    const int32 LastPage = FMath::Clamp(FirstIndex + Count - 1, 0, NumStrings - 1) / StringsPerPage;
+
+    for (int32 PageIndex = FirstPage; PageIndex <= LastPage; ++PageIndex)
+    {
+        FPage& Page = Pages[PageIndex];
+        if (Page.bResident || Page.PendingRequest)
+        {
+            continue;
+        }
+
+        // Pages built in this session are still in memory, there is nothing to stream
+        if (!Page.BulkData.CanLoadFromDisk())
+        {
+            LoadPage(PageIndex);
+            continue;
+        }
+
+        // The read buffer is allocated now, make room for it or leave the rest to on-demand loads
+        const int64 PageBytes = Page.BulkData.GetBulkDataSize();
+        if (!EnforceBudget(INDEX_NONE, PageBytes))
+        {
+            break;
+        }
+
+        Page.Payload.SetNumUninitialized(PageBytes);
+        Page.PendingRequest = Page.BulkData.CreateStreamingRequest(AIOP_Normal, nullptr, Page.Payload.GetData());
+        if (!Page.PendingRequest)
+        {
+            Page.Payload.Empty();
+            continue;
+        }
+
+        Page.LastAccess = ++AccessCounter;
+        ResidentBytes += PageBytes;
+    }
+}
+
+void UChunkedSaveDataAsset::BuildFromStrings(const TArray<FString>& Values)
+{
+    ReleasePendingReads();
+    Modify();
+
+    Pages.Empty();
+    ResidentBytes = 0;
+    NumStrings = Values.Num();
+    StringsPerPage = FMath::Max(PageSize, 16);
+
+    for (int32 First = 0; First < NumStrings; First += StringsPerPage)
+    {
+        const int32 Count = FMath::Min(StringsPerPage, NumStrings - First);
+
+        TArray<int32> Offsets;
+        TArray<uint8> Strings;
+        Offsets.Reserve(Count);
+
+        for (int32 Index = First; Index < First + Count; ++Index)
+        {
+            const FTCHARToUTF8 Utf8(*Values[Index]);
+            Offsets.Add(Strings.Num());
+            Strings.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+            Strings.Add(0);
+        }
+
+        FPage* Page = new FPage();
+        Page->Payload.Append(reinterpret_cast<const uint8*>(&Count), sizeof(int32));
+        Page->Payload.Append(reinterpret_cast<const uint8*>(Offsets.GetData()), Offsets.Num() * sizeof(int32));
+        Page->Payload.Append(Strings);
+
+        // Out-of-line payloads are not read when the asset itself is loaded
+        Page->BulkData.SetBulkDataFlags(BULKDATA_Force_NOT_InlinePayload);
+        Page->BulkData.Lock(LOCK_READ_WRITE);
+        FMemory::Memcpy(Page->BulkData.Realloc(Page->Payload.Num()), Page->Payload.GetData(), Page->Payload.Num());
+        Page->BulkData.Unlock();
+
+        Page->Payload.Empty();
+        Pages.Add(Page);
+    }
+
+    MarkPackageDirty();
+}
+
+void UChunkedSaveDataAsset::BuildFromDataAsset(const UUSaveDataAsset* Source)
+{
+    if (Source)
+    {
+        BuildFromStrings(Source->GetAllStrings());
+    }
+}
+
+void UChunkedSaveDataAsset::Serialize(FArchive& Ar)
+{
+    Super::Serialize(Ar);
+
+    Ar << NumStrings;
+    Ar << StringsPerPage;
+
+    int32 NumPages = Pages.Num();
+    Ar << NumPages;
+
+    if (Ar.IsLoading())
+    {
+        ReleasePendingReads();
+        Pages.Empty(NumPages);
+        ResidentBytes = 0;
+        for (int32 PageIndex = 0; PageIndex < NumPages; ++PageIndex)
+        {
+            Pages.Add(new FPage());
+        }
+    }
+
+    for (FPage& Page : Pages)
+    {
+        Page.BulkData.Serialize(Ar, this);
+    }
+}
+
+void UChunkedSaveDataAsset::BeginDestroy()
+{
+    ReleasePendingReads();
+
+    Super::BeginDestroy();
+}
+
+void UChunkedSaveDataAsset::LoadPage(int32 PageIndex)
+{
+    FPage& Page = Pages[PageIndex];
+    Page.LastAccess = ++AccessCounter;
+
+    if (!Page.bResident && !(Page.PendingRequest && CompletePendingRead(Page, true)))
+    {
+        Page.Payload.SetNumUninitialized(Page.BulkData.GetBulkDataSize());
+        void* Destination = Page.Payload.GetData();
+        Page.BulkData.GetCopy(&Destination, true);
+
+        Page.bResident = true;
+        ResidentBytes += Page.Payload.Num();
+    }
+
+    EnforceBudget(PageIndex);
+}
+
+bool UChunkedSaveDataAsset::CompletePendingRead(FPage& Page, bool bWait)
+{
+    if (bWait)
+    {
+        Page.PendingRequest->WaitCompletion();
+    }
+    else if (!Page.PendingRequest->PollCompletion())
+    {
+        return false;
+    }
+
+    // The request read straight into the payload buffer, already counted in ResidentBytes
+    const bool bSucceeded = Page.PendingRequest->GetReadResults() != nullptr;
+    delete Page.PendingRequest;
+    Page.PendingRequest = nullptr;
+
+    if (bSucceeded)
+    {
+        Page.bResident = true;
+    }
+    else
+    {
+        ResidentBytes -= Page.Payload.Num();
+        Page.Payload.Empty();
+    }
+
+    return bSucceeded;
+}
+
+void UChunkedSaveDataAsset::PollPendingReads()
+{
+    for (FPage& Page : Pages)
+    {
+        if (Page.PendingRequest)
+        {
+            CompletePendingRead(Page, false);
+        }
+    }
+}
+
+bool UChunkedSaveDataAsset::EnforceBudget(int32 PinnedPage, int64 IncomingBytes)
+{
+    const int64 BudgetBytes = int64(MaxResidentKB) * 1024;
+    if (BudgetBytes <= 0)
+    {
+        return true;
+    }
+
+    while (ResidentBytes + IncomingBytes > BudgetBytes)
+    {
+        int32 Oldest = INDEX_NONE;
+        for (int32 PageIndex = 0; PageIndex < Pages.Num(); ++PageIndex)
+        {
+            if (PageIndex != PinnedPage && Pages[PageIndex].bResident
+                && (Oldest == INDEX_NONE || Pages[PageIndex].LastAccess < Pages[Oldest].LastAccess))
+            {
+                Oldest = PageIndex;
+            }
+        }
+
+        // Only pending reads and the pinned page are left
+        if (Oldest == INDEX_NONE)
+        {
+            return false;
+        }
+
+        FPage& Page = Pages[Oldest];
+        ResidentBytes -= Page.Payload.Num();
+        Page.Payload.Empty();
+        Page.bResident = false;
+    }
+
+    return true;
+}
+
+void UChunkedSaveDataAsset::ReleasePendingReads()
+{
+    for (FPage& Page : Pages)
+    {
+        if (Page.PendingRequest)
+        {
+            Page.PendingRequest->Cancel();
+            Page.PendingRequest->WaitCompletion();
+            delete Page.PendingRequest;
+            Page.PendingRequest = nullptr;
+            ResidentBytes -= Page.Payload.Num();
+            Page.Payload.Empty();
+        }
+    }
+}
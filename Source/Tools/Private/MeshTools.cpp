@@ -13,9 +13,306 @@
 #include "Editor.h"
 #include "Editor/EditorEngine.h"
 #include "EngineUtils.h"
+#include "Async/ParallelFor.h"
+#include "StaticMeshCompiler.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+#include "Math/Float16.h"
+#include "Math/VectorRegister.h"
+#include "PackedNormal.h"
+#include "Engine/MeshMerging.h"
+#include "IMeshMergeUtilities.h"
+#include "MeshMergeModule.h"
+#include "ScopedTransaction.h"
+#include "ToolsStats.h"
+#include "ToolsJobSubsystem.h"
+#include "MeshToolsCache.h"
+#include "ToolsAssetRegistryCache.h"
+#include "ObjectTools.h"
+#include "Hash/xxhash.h"
+#include "PhysicsEngine/BodySetup.h"
+
+namespace MeshToolsPrivate
+{
+    /** Size of the .uasset backing the given asset, 0 if it has not been saved yet */
+    int64 GetPackageFileSize(const UObject* Asset)
+    {
+        FString PackageFilePath;
+        if (FPackageName::TryConvertLongPackageNameToFilename(Asset->GetOutermost()->GetName(), PackageFilePath, FPackageName::GetAssetPackageExtension()))
+        {
+            return FMath::Max<int64>(IFileManager::Get().FileSize(*PackageFilePath), 0);
+        }
+
+        return 0;
+    }
+
+    /** Largest absolute error introduced by storing the given floats as 16-bit halves */
+    float ComputeHalfPrecisionError(const float* Values, int64 NumValues)
+    {
+        VectorRegister4Float MaxError = VectorZeroFloat();
+
+        int64 Index = 0;
+        for (; Index + 4 <= NumValues; Index += 4)
+        {
+            alignas(16) uint16 Halves[4];
+            alignas(16) float RoundTrip[4];
+            FPlatformMath::VectorStoreHalf(Halves, Values + Index);
+            FPlatformMath::VectorLoadHalf(RoundTrip, Halves);
+
+            const VectorRegister4Float Error = VectorAbs(VectorSubtract(VectorLoad(Values + Index), VectorLoadAligned(RoundTrip)));
+            MaxError = VectorMax(MaxError, Error);
+        }
+
+        alignas(16) float Lanes[4];
+        VectorStoreAligned(MaxError, Lanes);
+        float Result = FMath::Max(FMath::Max(Lanes[0], Lanes[1]), FMath::Max(Lanes[2], Lanes[3]));
+
+        for (; Index < NumValues; ++Index)
+        {
+            Result = FMath::Max(Result, FMath::Abs(Values[Index] - FFloat16(Values[Index]).GetFloat()));
+        }
+
+        return Result;
+    }
+
+    /** Smallest cosine between 16-bit tangent basis vectors and their 8-bit (FPackedNormal) quantization */
+    float ComputeTangentQuantizationMinCos(const FPackedRGBA16N* Tangents, int64 NumTangents)
+    {
+        const VectorRegister4Float Scale = VectorSetFloat1(127.0f);
+        const VectorRegister4Float InvScale = VectorSetFloat1(1.0f / 127.0f);
+        const VectorRegister4Float Epsilon = VectorSetFloat1(UE_SMALL_NUMBER);
+        VectorRegister4Float MinCos = VectorOneFloat();
+
+        for (int64 Index = 0; Index < NumTangents; ++Index)
+        {
+            const VectorRegister4Float Source = VectorLoadSRGBA16N(&Tangents[Index]);
+
+            // Round to nearest the same way FPackedNormal does
+            const VectorRegister4Float Scaled = VectorMultiply(Source, Scale);
+            const VectorRegister4Float Rounded = VectorTruncate(VectorAdd(Scaled, VectorMultiply(VectorSign(Scaled), GlobalVectorConstants::FloatOneHalf)));
+            const VectorRegister4Float Quantized = VectorMultiply(Rounded, InvScale);
+
+            const VectorRegister4Float SourceLengthSq = VectorDot3(Source, Source);
+            const VectorRegister4Float LengthSq = VectorMax(VectorMultiply(SourceLengthSq, VectorDot3(Quantized, Quantized)), Epsilon);
+            const VectorRegister4Float Cos = VectorMultiply(VectorDot3(Source, Quantized), VectorReciprocalSqrtAccurate(LengthSq));
+
+            // Degenerate tangents carry no direction to preserve
+            MinCos = VectorMin(MinCos, VectorSelect(VectorCompareLT(SourceLengthSq, Epsilon), VectorOneFloat(), Cos));
+        }
+
+        return VectorGetComponent(MinCos, 0);
+    }
+
+    /** Every material and material instance asset within the /Game directory */
+    FARFilter MakeMaterialFilter()
+    {
+        FARFilter Filter;
+        Filter.bRecursivePaths = true;
+        Filter.PackagePaths.Add("/Game");
+
+        // Use ClassPaths instead of deprecated ClassNames
+        // "/Script/Engine.Material" = UMaterial
+        // "/Script/Engine.MaterialInstanceConstant" = UMaterialInstanceConstant
+        Filter.ClassPaths.Add(FTopLevelAssetPath("/Script/Engine", "Material"));
+        Filter.ClassPaths.Add(FTopLevelAssetPath("/Script/Engine", "MaterialInstanceConstant"));
+        return Filter;
+    }
+
+    /** Output of GenerateLODsForMesh as seen on the mesh, 0 when the LOD does not exist */
+    uint64 HashLODSettings(const UStaticMesh* Mesh, int32 LODIndex)
+    {
+        if (LODIndex >= Mesh->GetNumSourceModels())
+        {
+            return 0;
+        }
+
+        const FStaticMeshSourceModel& SourceModel = Mesh->GetSourceModel(LODIndex);
+        const FString Settings = FString::Printf(TEXT("%d %f %f"), LODIndex, SourceModel.ReductionSettings.PercentTriangles, SourceModel.ScreenSize.Default);
+        return FXxHash64::HashBuffer(*Settings, Settings.Len() * sizeof(TCHAR)).Hash;
+    }
+
+    /** Output of GenerateSimpleCollision as seen on the mesh, 0 without simple collision */
+    uint64 HashSimpleCollision(const UStaticMesh* Mesh)
+    {
+        const UBodySetup* BodySetup = Mesh->GetBodySetup();
+        if (!BodySetup || BodySetup->AggGeom.ConvexElems.Num() == 0)
+        {
+            return 0;
+        }
+
+        FXxHash64Builder Builder;
+        for (const FKConvexElem& Convex : BodySetup->AggGeom.ConvexElems)
+        {
+            Builder.Update(Convex.VertexData.GetData(), Convex.VertexData.Num() * sizeof(FVector));
+        }
+        return Builder.Finalize().Hash;
+    }
+
+    /** Instances read per batch by FindDuplicateMaterialInstances before garbage collection */
+    constexpr int32 MaterialInstanceBatchSize = 32;
+
+    FString MakeParameterInfoKey(const FMaterialParameterInfo& Info)
+    {
+        return FString::Printf(TEXT("%s:%d:%d"), *Info.Name.ToString(), static_cast<int32>(Info.Association), Info.Index);
+    }
+
+    /** Resolved static switches and masks plus the overridden base properties, what selects the shader permutation */
+    FString MakeStaticSignature(UMaterialInterface* Material)
+    {
+        FStaticParameterSet StaticParameters;
+        Material->GetStaticParameterValues(StaticParameters);
+
+        TArray<FString> Entries;
+        for (const FStaticSwitchParameter& Switch : StaticParameters.StaticSwitchParameters)
+        {
+            Entries.Add(FString::Printf(TEXT("%s=%d"), *MakeParameterInfoKey(Switch.ParameterInfo), Switch.Value ? 1 : 0));
+        }
+        for (const FStaticComponentMaskParameter& Mask : StaticParameters.EditorOnly.StaticComponentMaskParameters)
+        {
+            Entries.Add(FString::Printf(TEXT("%s=%d%d%d%d"), *MakeParameterInfoKey(Mask.ParameterInfo), Mask.R, Mask.G, Mask.B, Mask.A));
+        }
+
+        if (const UMaterialInstance* Instance = Cast<UMaterialInstance>(Material))
+        {
+            const FMaterialInstanceBasePropertyOverrides& Overrides = Instance->BasePropertyOverrides;
+            if (Overrides.bOverride_BlendMode)
+            {
+                Entries.Add(FString::Printf(TEXT("BlendMode=%d"), static_cast<int32>(Overrides.BlendMode)));
+            }
+            if (Overrides.bOverride_ShadingModel)
+            {
+                Entries.Add(FString::Printf(TEXT("ShadingModel=%d"), static_cast<int32>(Overrides.ShadingModel)));
+            }
+            if (Overrides.bOverride_TwoSided)
+            {
+                Entries.Add(FString::Printf(TEXT("TwoSided=%d"), Overrides.TwoSided ? 1 : 0));
+            }
+            if (Overrides.bOverride_DitheredLODTransition)
+            {
+                Entries.Add(FString::Printf(TEXT("DitheredLODTransition=%d"), Overrides.DitheredLODTransition ? 1 : 0));
+            }
+        }
+
+        Entries.Sort();
+        return FString::Join(Entries, TEXT(";"));
+    }
+
+    FString MakeParameterValueKey(const FMaterialParameterValue& Value)
+    {
+        switch (Value.Type)
+        {
+        case EMaterialParameterType::Scalar:
+            return FString::Printf(TEXT("%.9g"), Value.AsScalar());
+        case EMaterialParameterType::Vector:
+        {
+            const FLinearColor Color = Value.AsLinearColor();
+            return FString::Printf(TEXT("%.9g,%.9g,%.9g,%.9g"), Color.R, Color.G, Color.B, Color.A);
+        }
+        case EMaterialParameterType::DoubleVector:
+        {
+            const FVector4d Vector = Value.AsVector4d();
+            return FString::Printf(TEXT("%.17g,%.17g,%.17g,%.17g"), Vector.X, Vector.Y, Vector.Z, Vector.W);
+        }
+        default:
+            // Textures, fonts, runtime and sparse volume textures
+            return GetPathNameSafe(Value.AsTextureObject());
+        }
+    }
+
+    /** Every runtime parameter as the instance resolves it, overridden or inherited, sorted so equal instances give equal strings */
+    FString MakeParameterSignature(const UMaterialInstance* Instance)
+    {
+        TArray<FString> Entries;
+        for (int32 TypeIndex = 0; TypeIndex < NumMaterialRuntimeParameterTypes; ++TypeIndex)
+        {
+            TMap<FMaterialParameterInfo, FMaterialParameterMetadata> Parameters;
+            Instance->GetAllParametersOfType(static_cast<EMaterialParameterType>(TypeIndex), Parameters);
+
+            for (const TPair<FMaterialParameterInfo, FMaterialParameterMetadata>& Parameter : Parameters)
+            {
+                Entries.Add(FString::Printf(TEXT("%d %s=%s"), TypeIndex, *MakeParameterInfoKey(Parameter.Key), *MakeParameterValueKey(Parameter.Value.Value)));
+            }
+        }
+
+        const FMaterialInstanceBasePropertyOverrides& Overrides = Instance->BasePropertyOverrides;
+        if (Overrides.bOverride_OpacityMaskClipValue)
+        {
+            Entries.Add(FString::Printf(TEXT("OpacityMaskClipValue=%.9g"), Overrides.OpacityMaskClipValue));
+        }
+        Entries.Add(FString::Printf(TEXT("PhysMaterial=%s"), *GetPathNameSafe(Instance->GetPhysicalMaterial())));
+
+        Entries.Sort();
+        return FString::Join(Entries, TEXT(";"));
+    }
+
+    /** Vertex factories the base material is compiled for: the static mesh one plus each usage flag set */
+    int32 CountMaterialUsages(const UMaterial* Material)
+    {
+        int32 NumUsages = 1;
+        for (int32 Usage = 0; Usage < MATUSAGE_MAX; ++Usage)
+        {
+            NumUsages += Material->GetUsageByFlag(static_cast<EMaterialUsage>(Usage)) ? 1 : 0;
+        }
+        return NumUsages;
+    }
+
+    /** High quality lightmaps: two DXT5 coefficient textures at one byte per texel, plus a third for the mips */
+    constexpr double LightmapBytesPerTexel = 2.0 * 4.0 / 3.0;
+
+    int64 EstimateLightmapBytes(int32 Resolution)
+    {
+        return static_cast<int64>(FMath::Square(static_cast<double>(Resolution)) * LightmapBytesPerTexel);
+    }
+
+    /** LOD0 surface and area covered in the UV channel (the whole UV space being 1), from the render data */
+    void MeasureLightmapCoverage(const UStaticMesh* Mesh, int32 UVChannel, double& OutSurfaceArea, double& OutUVArea)
+    {
+        OutSurfaceArea = 0.0;
+        OutUVArea = 0.0;
+
+        const FStaticMeshRenderData* RenderData = Mesh->GetRenderData();
+        if (!RenderData || RenderData->LODResources.Num() == 0)
+        {
+            return;
+        }
+
+        const FStaticMeshLODResources& LOD = RenderData->LODResources[0];
+        const FPositionVertexBuffer& Positions = LOD.VertexBuffers.PositionVertexBuffer;
+        const FStaticMeshVertexBuffer& VertexBuffer = LOD.VertexBuffers.StaticMeshVertexBuffer;
+        const bool bHasUVChannel = UVChannel >= 0 && UVChannel < static_cast<int32>(VertexBuffer.GetNumTexCoords());
+        const FIndexArrayView Indices = LOD.IndexBuffer.GetArrayView();
+
+        for (int32 Index = 0; Index + 2 < Indices.Num(); Index += 3)
+        {
+            const uint32 I0 = Indices[Index];
+            const uint32 I1 = Indices[Index + 1];
+            const uint32 I2 = Indices[Index + 2];
+
+            const FVector3f P0 = Positions.VertexPosition(I0);
+            OutSurfaceArea += 0.5 * FVector3f::CrossProduct(Positions.VertexPosition(I1) - P0, Positions.VertexPosition(I2) - P0).Size();
+
+            // Overlapping charts are counted once per triangle, which pushes the total above 1
+            if (bHasUVChannel)
+            {
+                const FVector2f UV0 = VertexBuffer.GetVertexUV(I0, UVChannel);
+                OutUVArea += 0.5 * FMath::Abs(FVector2f::CrossProduct(VertexBuffer.GetVertexUV(I1, UVChannel) - UV0, VertexBuffer.GetVertexUV(I2, UVChannel) - UV0));
+            }
+        }
+    }
+
+    /** Power of two closest to the resolution giving the target density to the charts, within the bounds */
+    int32 ProposeLightmapResolution(double SurfaceAreaMeters, double UVUtilization, const FLightmapBatchOptions& Options)
+    {
+        // Charts only cover part of the texture, the texture grows so they keep the density
+        const double Side = FMath::Sqrt(SurfaceAreaMeters / FMath::Min(UVUtilization, 1.0)) * Options.TexelsPerMeter;
+        const int32 Resolution = 1 << FMath::Clamp(FMath::RoundToInt(FMath::Log2(FMath::Max(Side, 1.0))), 0, 30);
+        return FMath::Clamp(Resolution, Options.MinResolution, FMath::Max(Options.MinResolution, Options.MaxResolution));
+    }
+}
 
 void UMeshTools::GenerateLODsForMesh(UStaticMesh* Mesh, int LODIndex, FVector2D LODsValues)
 {
+    TOOLS_OPERATION_SCOPE("GenerateLODsForMesh");
 
     // Chargement du systme de rduction de mesh
     IMeshReduction* MeshReduction = nullptr;
@@ -48,7 +345,11 @@ void UMeshTools::GenerateLODsForMesh(UStaticMesh* Mesh, int LODIndex, FVector2D
     LODModel.ScreenSize.Default = LODsValues.Y;
 
     // Reconstruction du mesh
-    Mesh->Build(false);
+    {
+        TOOLS_PHASE_SCOPE("Build", STAT_Tools_MeshBuild);
+        Mesh->Build(false);
+        FToolsOperationProfile::CountBuilds(1);
+    }
     Mesh->MarkPackageDirty();
     Mesh->Modify();
 
@@ -62,208 +363,1109 @@ void UMeshTools::GenerateLODsForMesh(UStaticMesh* Mesh, int LODIndex, FVector2D
 
 void UMeshTools::ClearLODs(UStaticMesh* Mesh)
 {
+    TOOLS_OPERATION_SCOPE("ClearLODs");
+
     // Nettoyer les LODs existants (ne garder que LOD0)
-    int32 ExistingLODCount = Mesh->GetNumSourceModels();
-    if (ExistingLODCount > 1)
-    {
-        Mesh->SetNumSourceModels(1);
-    }
+    RemoveExtraSourceModels(Mesh);
 
     // Reconstruit et sauvegarde les changements
-    Mesh->Build(false);
+    {
+        TOOLS_PHASE_SCOPE("Build", STAT_Tools_MeshBuild);
+        Mesh->Build(false);
+        FToolsOperationProfile::CountBuilds(1);
+    }
     Mesh->MarkPackageDirty();
     Mesh->Modify();
     Mesh->PostEditChange();
 }
 
+int32 UMeshTools::RemoveExtraSourceModels(UStaticMesh* Mesh)
+{
+    const int32 ExistingLODCount = Mesh->GetNumSourceModels();
+    if (ExistingLODCount > 1)
+    {
+        Mesh->SetNumSourceModels(1);
+    }
+
+    return FMath::Max(ExistingLODCount - 1, 0);
+}
+
 void UMeshTools::GenerateSimpleCollision(UStaticMesh* Mesh)
 {
     if (!Mesh) return;
 
-    // S'assure que le BodySetup existe
-    if (!Mesh->GetBodySetup())
+    TOOLS_OPERATION_SCOPE("GenerateSimpleCollision");
+
+    TArray<FVector> ConvexVerts;
+    if (!GatherCollisionPoints(Mesh, ConvexVerts)) return;
+
     {
-        Mesh->CreateBodySetup();
+        TOOLS_PHASE_SCOPE("Weld Hull Points", STAT_Tools_Analysis);
+        WeldCollisionPoints(ConvexVerts);
     }
 
-    UBodySetup* BodySetup = Mesh->GetBodySetup();
-    BodySetup->RemoveSimpleCollision(); // Nettoie les anciennes collisions
+    ApplyCollisionPoints(Mesh, MoveTemp(ConvexVerts));
+}
 
-    // Cre une collision convexe  partir du mesh LOD 0
-    TArray<FKAggregateGeom> AggregateGeoms;
-    FKAggregateGeom& AggGeom = BodySetup->AggGeom;
+bool UMeshTools::GenerateLODsForMeshIncremental(UStaticMesh* Mesh, int LODIndex, FVector2D LODsValues)
+{
+    if (!Mesh || LODIndex < 1)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("GenerateLODsForMeshIncremental: Invalid mesh or LOD index %d"), LODIndex);
+        return false;
+    }
 
-    // Gnre une forme convexe (enveloppe simple)
-    AggGeom.ConvexElems.Add(FKConvexElem());
+    // GenerateLODsForMesh appends, so a LOD past the end lands on the next free index
+    LODIndex = FMath::Min(LODIndex, Mesh->GetNumSourceModels());
+
+    FMeshToolsCache& Cache = FMeshToolsCache::Get();
+    const uint64 Key = FMeshToolsCache::MakeKey(Mesh, TEXT("GenerateLODs"), FString::Printf(TEXT("%d %f %f"), LODIndex, LODsValues.X, LODsValues.Y));
+    if (Cache.IsUpToDate(Key, MeshToolsPrivate::HashLODSettings(Mesh, LODIndex)))
+    {
+        return false;
+    }
 
-    FKConvexElem& Convex = AggGeom.ConvexElems.Last();
-    FStaticMeshRenderData* RenderData = Mesh->GetRenderData();
-    if (!RenderData || RenderData->LODResources.Num() == 0) return;
+    // Drop the stale LOD and the ones generated after it, they are rebuilt by the next calls
+    if (Mesh->GetNumSourceModels() > LODIndex)
+    {
+        Mesh->SetNumSourceModels(LODIndex);
+    }
 
-    const FStaticMeshLODResources& LOD = RenderData->LODResources[Mesh->GetNumSourceModels() - 1];
-    const FPositionVertexBuffer& VertexBuffer = LOD.VertexBuffers.PositionVertexBuffer;
+    GenerateLODsForMesh(Mesh, LODIndex, LODsValues);
+    Cache.Record(Key, MeshToolsPrivate::HashLODSettings(Mesh, LODIndex));
+    return true;
+}
 
-    TArray<FVector> ConvexVerts;
+bool UMeshTools::GenerateSimpleCollisionIncremental(UStaticMesh* Mesh)
+{
+    if (!Mesh || Mesh->GetNumSourceModels() == 0) return false;
+
+    // The hull is taken from the last LOD, its reduction is part of the input
+    const int32 LastLODIndex = Mesh->GetNumSourceModels() - 1;
+    const FString Parameters = FString::Printf(TEXT("%d %f"), LastLODIndex, Mesh->GetSourceModel(LastLODIndex).ReductionSettings.PercentTriangles);
+
+    FMeshToolsCache& Cache = FMeshToolsCache::Get();
+    const uint64 Key = FMeshToolsCache::MakeKey(Mesh, TEXT("GenerateSimpleCollision"), Parameters);
+    if (Cache.IsUpToDate(Key, MeshToolsPrivate::HashSimpleCollision(Mesh)))
+    {
+        return false;
+    }
+
+    GenerateSimpleCollision(Mesh);
+    Cache.Record(Key, MeshToolsPrivate::HashSimpleCollision(Mesh));
+    return true;
+}
+
+bool UMeshTools::GatherCollisionPoints(const UStaticMesh* Mesh, TArray<FVector>& OutPoints)
+{
+    const FStaticMeshRenderData* RenderData = Mesh->GetRenderData();
+    if (!RenderData || RenderData->LODResources.Num() == 0 || Mesh->GetNumSourceModels() == 0) return false;
+
+    const FStaticMeshLODResources& LOD = RenderData->LODResources[FMath::Min(Mesh->GetNumSourceModels(), RenderData->LODResources.Num()) - 1];
+    const FPositionVertexBuffer& VertexBuffer = LOD.VertexBuffers.PositionVertexBuffer;
 
     int32 VertexCount = VertexBuffer.GetNumVertices();
+    OutPoints.Reset(VertexCount);
     for (int32 i = 0; i < VertexCount; ++i)
     {
-        FVector Position = FVector(VertexBuffer.VertexPosition(i));
-        ConvexVerts.Add(Position);
+        OutPoints.Add(FVector(VertexBuffer.VertexPosition(i)));
+    }
+
+    return true;
+}
+
+void UMeshTools::WeldCollisionPoints(TArray<FVector>& Points)
+{
+    // Split vertices (UV seams, hard edges) do not change the hull, only the cooking time
+    TSet<FVector> Unique;
+    Unique.Reserve(Points.Num());
+    Unique.Append(Points);
+    Points = Unique.Array();
+}
+
+void UMeshTools::ApplyCollisionPoints(UStaticMesh* Mesh, TArray<FVector>&& Points)
+{
+    // S'assure que le BodySetup existe
+    if (!Mesh->GetBodySetup())
+    {
+        Mesh->CreateBodySetup();
     }
 
-    Convex.VertexData = ConvexVerts;
+    UBodySetup* BodySetup = Mesh->GetBodySetup();
+    BodySetup->RemoveSimpleCollision(); // Nettoie les anciennes collisions
+
+    // Gnre une forme convexe (enveloppe simple)
+    FKAggregateGeom& AggGeom = BodySetup->AggGeom;
+    FKConvexElem& Convex = AggGeom.ConvexElems.AddDefaulted_GetRef();
+
+    FToolsOperationProfile::CountBytesTouched(Points.Num() * sizeof(FVector));
+    Convex.VertexData = MoveTemp(Points);
     Convex.UpdateElemBox();
 
     // Marque le mesh comme modifi
-    BodySetup->InvalidatePhysicsData();
-    BodySetup->CreatePhysicsMeshes();
+    {
+        TOOLS_PHASE_SCOPE("Cook Physics", STAT_Tools_MeshBuild);
+        BodySetup->InvalidatePhysicsData();
+        BodySetup->CreatePhysicsMeshes();
+    }
     Mesh->MarkPackageDirty();
-    Mesh->Build(false);
+    {
+        TOOLS_PHASE_SCOPE("Build", STAT_Tools_MeshBuild);
+        Mesh->Build(false);
+        FToolsOperationProfile::CountBuilds(1);
+    }
 }
 
-int32 UMeshTools::ReplaceMaterialBatch(const TArray<UObject*>& Objects, const FString& MaterialToReplaceName, const FString& NewMaterialName)
+int32 UMeshTools::GenerateLODsAsync(const TArray<UStaticMesh*>& Meshes, FVector2D LODsValues)
 {
-    // Load the Asset Registry to search for materials
-    FAssetRegistryModule& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-
-    // Construct the full object path for the new material
-    FString NewMaterialObjectPath = FString::Printf(TEXT("/Game/%s.%s"), *NewMaterialName, *NewMaterialName);
-    FAssetData NewMaterialData = AssetRegistry.Get().GetAssetByObjectPath(FName(*NewMaterialObjectPath));
-    UMaterialInterface* NewMaterial = Cast<UMaterialInterface>(NewMaterialData.GetAsset());
-
-    if (!NewMaterial)
+    UToolsJobSubsystem* Jobs = UToolsJobSubsystem::Get();
+    if (!Jobs)
     {
-        UE_LOG(LogTemp, Warning, TEXT("ReplaceMaterialBatch: Failed to find NewMaterial '%s'. Aborting."), *NewMaterialObjectPath);
         return 0;
     }
 
-    // Optionally resolve MaterialToReplace (can be empty)
-    UMaterialInterface* MaterialToReplace = nullptr;
-    if (!MaterialToReplaceName.IsEmpty())
+    TSharedRef<TArray<TWeakObjectPtr<UStaticMesh>>> Pending = MakeShared<TArray<TWeakObjectPtr<UStaticMesh>>>(Meshes);
+    TSharedRef<int32> NextMesh = MakeShared<int32>(0);
+
+    // Builds cannot be split, one mesh per slice
+    TArray<FToolsJobPhase> Phases;
+    Phases.Add(FToolsJobPhase::GameThread(TEXT("Build LODs"), [Pending, NextMesh, LODsValues](FToolsJobContext& Context)
     {
-        FString OldMaterialObjectPath = FString::Printf(TEXT("/Game/%s.%s"), *MaterialToReplaceName, *MaterialToReplaceName);
-        FAssetData OldMaterialData = AssetRegistry.Get().GetAssetByObjectPath(FName(*OldMaterialObjectPath));
-        MaterialToReplace = Cast<UMaterialInterface>(OldMaterialData.GetAsset());
+        if (!Pending->IsValidIndex(*NextMesh))
+        {
+            return true;
+        }
 
-        if (!MaterialToReplace)
+        if (UStaticMesh* Mesh = (*Pending)[(*NextMesh)].Get())
         {
-            UE_LOG(LogTemp, Warning, TEXT("ReplaceMaterialBatch: Could not find MaterialToReplace '%s'. Continuing with global replacement."), *OldMaterialObjectPath);
+            GenerateLODsForMesh(Mesh, Mesh->GetNumSourceModels(), LODsValues);
         }
-    }
 
-    int32 ModifiedCount = 0;
+        Context.SetProgress(float(++(*NextMesh)) / Pending->Num());
+        return *NextMesh >= Pending->Num();
+    }));
 
-    for (UObject* Obj : Objects)
+    return Jobs->SubmitJob(FString::Printf(TEXT("Generate LODs (%d meshes)"), Meshes.Num()), MoveTemp(Phases));
+}
+
+int32 UMeshTools::GenerateSimpleCollisionAsync(const TArray<UStaticMesh*>& Meshes)
+{
+    UToolsJobSubsystem* Jobs = UToolsJobSubsystem::Get();
+    if (!Jobs)
     {
-        UStaticMesh* Mesh = Cast<UStaticMesh>(Obj);
-        if (!Mesh)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("ReplaceMaterialBatch: Skipping non-UStaticMesh object."));
-            continue;
-        }
+        return 0;
+    }
 
-        bool bModified = false;
-        TArray<FStaticMaterial>& StaticMaterials = Mesh->GetStaticMaterials();
+    struct FCollisionJobData
+    {
+        TArray<TWeakObjectPtr<UStaticMesh>> Meshes;
+        TArray<TArray<FVector>> Points;
+        int32 NextMesh = 0;
+    };
 
-        // Replace materials on the static mesh asset
-        for (FStaticMaterial& StaticMat : StaticMaterials)
+    TSharedRef<FCollisionJobData> Data = MakeShared<FCollisionJobData>();
+    Data->Meshes.Append(Meshes);
+    Data->Points.SetNum(Meshes.Num());
+
+    TArray<FToolsJobPhase> Phases;
+
+    // Render data can be rebuilt by the editor at any time, copy it on the game thread
+    Phases.Add(FToolsJobPhase::GameThread(TEXT("Copy Positions"), [Data](FToolsJobContext& Context)
+    {
+        for (int32 Index = 0; Index < Data->Meshes.Num(); ++Index)
         {
-            if (!MaterialToReplace || StaticMat.MaterialInterface == MaterialToReplace)
+            if (const UStaticMesh* Mesh = Data->Meshes[Index].Get())
             {
-                if (StaticMat.MaterialInterface != NewMaterial)
-                {
-                    StaticMat.MaterialInterface = NewMaterial;
-                    bModified = true;
-                }
+                GatherCollisionPoints(Mesh, Data->Points[Index]);
             }
         }
+        return true;
+    }));
 
-        if (bModified)
+    Phases.Add(FToolsJobPhase::Worker(TEXT("Weld Hull Points"), [Data](FToolsJobContext& Context)
+    {
+        ParallelFor(Data->Points.Num(), [&Data, &Context](int32 Index)
         {
-            // Mark asset dirty and save
-            Mesh->MarkPackageDirty();
-
-            const FString AssetPath = Mesh->GetPathName();
-            const bool bSaved = UEditorAssetLibrary::SaveAsset(AssetPath);
-
-            if (!bSaved)
+            if (Context.IsCancelled())
             {
-                UE_LOG(LogTemp, Warning, TEXT("ReplaceMaterialBatch: Failed to save modified mesh: %s"), *AssetPath);
+                return;
             }
 
-            // Update materials on all actors in the scene using this mesh
-            UWorld* World = GEditor->GetEditorWorldContext().World();
-            if (World)
-            {
-                for (TActorIterator<AStaticMeshActor> It(World); It; ++It)
-                {
-                    AStaticMeshActor* Actor = *It;
-                    if (!Actor || !Actor->GetStaticMeshComponent())
-                        continue;
-
-                    if (Actor->GetStaticMeshComponent()->GetStaticMesh() == Mesh)
-                    {
-                        int32 MatCount = Actor->GetStaticMeshComponent()->GetNumMaterials();
-                        for (int32 i = 0; i < MatCount; ++i)
-                        {
-                            UMaterialInterface* CurrentMat = Actor->GetStaticMeshComponent()->GetMaterial(i);
-                            if (!MaterialToReplace || CurrentMat == MaterialToReplace)
-                            {
-                                if (CurrentMat != NewMaterial)
-                                {
-                                    Actor->GetStaticMeshComponent()->SetMaterial(i, NewMaterial);
-                                }
-                            }
-                        }
+            WeldCollisionPoints(Data->Points[Index]);
+        });
+    }));
 
-                        Actor->Modify(); // Allow undo
-                        // Force the render state to update so material changes appear immediately
-                        Actor->GetStaticMeshComponent()->MarkRenderStateDirty();
-                    }
-                }
-            }
+    Phases.Add(FToolsJobPhase::GameThread(TEXT("Cook Collision"), [Data](FToolsJobContext& Context)
+    {
+        if (!Data->Meshes.IsValidIndex(Data->NextMesh))
+        {
+            return true;
+        }
 
-            ModifiedCount++;
+        const int32 Index = Data->NextMesh++;
+        UStaticMesh* Mesh = Data->Meshes[Index].Get();
+        if (Mesh && Data->Points[Index].Num() > 0)
+        {
+            TOOLS_OPERATION_SCOPE("GenerateSimpleCollision");
+            ApplyCollisionPoints(Mesh, MoveTemp(Data->Points[Index]));
         }
-    }
 
-    UE_LOG(LogTemp, Log, TEXT("ReplaceMaterialBatch: Modified %d meshes."), ModifiedCount);
-    return ModifiedCount;
+        Context.SetProgress(float(Data->NextMesh) / Data->Meshes.Num());
+        return Data->NextMesh >= Data->Meshes.Num();
+    }));
+
+    return Jobs->SubmitJob(FString::Printf(TEXT("Generate Simple Collision (%d meshes)"), Meshes.Num()), MoveTemp(Phases));
 }
 
-TArray<FAssetData> UMeshTools::GetAllMaterialAssets()
+TArray<FMeshCellMergeReport> UMeshTools::MergeLevelMeshesByCell(float CellSize, const FString& DestinationFolder, const TArray<FVector2D>& LODsValues, int32 MinActorsPerCell, bool bReplaceSourceActors)
 {
-    TArray<FAssetData> OutAssets;
+    TOOLS_OPERATION_SCOPE("MergeLevelMeshesByCell");
 
-    // Load the Asset Registry module (used to query assets in the editor)
-    FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+    TArray<FMeshCellMergeReport> Reports;
 
-    // Define the filter to search for materials only within the /Game directory
-    FARFilter Filter;
+    if (CellSize <= 0.0f)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MergeLevelMeshesByCell: CellSize must be positive."));
+        return Reports;
+    }
+
+    if (!DestinationFolder.StartsWith("/Game"))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MergeLevelMeshesByCell: Invalid folder path '%s'. It must start with '/Game'."), *DestinationFolder);
+        return Reports;
+    }
+
+    UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+    if (!World)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MergeLevelMeshesByCell: No editor world available."));
+        return Reports;
+    }
+
+    // Gather every static mesh component that can be baked into a cell mesh
+    ToolsOperationProfile.BeginPhase(TEXT("Analysis"));
+    TArray<UStaticMeshComponent*> Components;
+    for (TActorIterator<AStaticMeshActor> It(World); It; ++It)
+    {
+        UStaticMeshComponent* Component = It->GetStaticMeshComponent();
+        if (Component && Component->GetStaticMesh() && Component->Mobility == EComponentMobility::Static)
+        {
+            Components.Add(Component);
+        }
+    }
+
+    // Resource size of every unique source mesh, queried once on the game thread
+    TMap<UStaticMesh*, int64> MeshSizes;
+    for (UStaticMeshComponent* Component : Components)
+    {
+        UStaticMesh* Mesh = Component->GetStaticMesh();
+        if (!MeshSizes.Contains(Mesh))
+        {
+            MeshSizes.Add(Mesh, Mesh->GetResourceSizeBytes(EResourceSizeMode::Exclusive));
+        }
+    }
+
+    // Bucket components into grid cells (read-only on cached bounds, safe on worker threads)
+    TArray<FIntPoint> ComponentCells;
+    ComponentCells.SetNumUninitialized(Components.Num());
+    ParallelFor(Components.Num(), [&Components, &ComponentCells, CellSize](int32 Index)
+    {
+        const FVector Origin = Components[Index]->Bounds.Origin;
+        ComponentCells[Index] = FIntPoint(FMath::FloorToInt(Origin.X / CellSize), FMath::FloorToInt(Origin.Y / CellSize));
+    });
+
+    TMap<FIntPoint, TArray<UStaticMeshComponent*>> Cells;
+    for (int32 Index = 0; Index < Components.Num(); ++Index)
+    {
+        Cells.FindOrAdd(ComponentCells[Index]).Add(Components[Index]);
+    }
+
+    FToolsOperationProfile::CountAssetsScanned(Components.Num());
+
+    TArray<FIntPoint> CellKeys;
+    for (const TPair<FIntPoint, TArray<UStaticMeshComponent*>>& Pair : Cells)
+    {
+        if (Pair.Value.Num() >= FMath::Max(MinActorsPerCell, 1))
+        {
+            CellKeys.Add(Pair.Key);
+        }
+    }
+
+    // Measure the current cost of every cell in parallel
+    Reports.SetNum(CellKeys.Num());
+    ParallelFor(CellKeys.Num(), [&Cells, &CellKeys, &MeshSizes, &Reports](int32 Index)
+    {
+        FMeshCellMergeReport& Report = Reports[Index];
+        const TArray<UStaticMeshComponent*>& CellComponents = Cells[CellKeys[Index]];
+
+        Report.Cell = CellKeys[Index];
+        Report.SourceActorCount = CellComponents.Num();
+
+        TSet<UStaticMesh*> UniqueMeshes;
+        for (UStaticMeshComponent* Component : CellComponents)
+        {
+            UStaticMesh* Mesh = Component->GetStaticMesh();
+            const FStaticMeshRenderData* RenderData = Mesh->GetRenderData();
+            if (RenderData && RenderData->LODResources.Num() > 0)
+            {
+                Report.DrawCallsBefore += RenderData->LODResources[0].Sections.Num();
+            }
+
+            bool bAlreadyCounted = false;
+            UniqueMeshes.Add(Mesh, &bAlreadyCounted);
+            if (!bAlreadyCounted)
+            {
+                Report.MemoryBeforeBytes += MeshSizes.FindRef(Mesh);
+            }
+        }
+    });
+
+    ToolsOperationProfile.EndPhase();
+
+    const IMeshMergeUtilities& MergeUtilities = FModuleManager::Get().LoadModuleChecked<IMeshMergeModule>("MeshMergeUtilities").GetUtilities();
+
+    // Keep source materials but collapse identical ones into a single slot
+    FMeshMergingSettings MergeSettings;
+    MergeSettings.LODSelectionType = EMeshLODSelectionType::SpecificLOD;
+    MergeSettings.SpecificLOD = 0;
+    MergeSettings.bMergeMaterials = false;
+    MergeSettings.bMergeEquivalentMaterials = true;
+    MergeSettings.bPivotPointAtZero = false;
+
+    const FScopedTransaction Transaction(NSLOCTEXT("MeshTools", "MergeLevelMeshesByCell", "Merge Level Meshes By Cell"));
+
+    // Asset creation, builds and actor edits must happen on the game thread
+    for (FMeshCellMergeReport& Report : Reports)
+    {
+        const TArray<UStaticMeshComponent*>& CellComponents = Cells[Report.Cell];
+        TArray<UPrimitiveComponent*> ComponentsToMerge(CellComponents);
+
+        const FString PackageName = FString::Printf(TEXT("%s/SM_MergedCell_%d_%d"), *DestinationFolder, Report.Cell.X, Report.Cell.Y);
+
+        TArray<UObject*> CreatedAssets;
+        FVector MergedLocation = FVector::ZeroVector;
+        {
+            TOOLS_PHASE_SCOPE("Merge", STAT_Tools_MeshBuild);
+            MergeUtilities.MergeComponentsToStaticMesh(ComponentsToMerge, World, MergeSettings, nullptr, nullptr, PackageName, CreatedAssets, MergedLocation, TNumericLimits<float>::Max(), true);
+            FToolsOperationProfile::CountBuilds(1);
+        }
+
+        UStaticMesh* MergedMesh = nullptr;
+        for (UObject* Asset : CreatedAssets)
+        {
+            FAssetRegistryModule::AssetCreated(Asset);
+            if (UStaticMesh* CreatedMesh = Cast<UStaticMesh>(Asset))
+            {
+                MergedMesh = CreatedMesh;
+            }
+        }
+
+        if (!MergedMesh)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("MergeLevelMeshesByCell: Failed to merge cell (%d, %d)."), Report.Cell.X, Report.Cell.Y);
+            continue;
+        }
+
+        // LOD0 is the merged source, generated LODs start at index 1
+        for (int32 LODIndex = 0; LODIndex < LODsValues.Num(); ++LODIndex)
+        {
+            GenerateLODsForMesh(MergedMesh, LODIndex + 1, LODsValues[LODIndex]);
+        }
+
+        {
+            TOOLS_PHASE_SCOPE("Save", STAT_Tools_Save);
+            if (!UEditorAssetLibrary::SaveLoadedAsset(MergedMesh))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("MergeLevelMeshesByCell: Failed to save merged mesh: %s"), *MergedMesh->GetPathName());
+            }
+            FToolsOperationProfile::CountSaves(1);
+        }
+
+        const FStaticMeshRenderData* MergedRenderData = MergedMesh->GetRenderData();
+        if (MergedRenderData && MergedRenderData->LODResources.Num() > 0)
+        {
+            Report.DrawCallsAfter = MergedRenderData->LODResources[0].Sections.Num();
+        }
+        Report.MemoryAfterBytes = MergedMesh->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+        Report.MergedMesh = MergedMesh;
+        FToolsOperationProfile::CountBytesTouched(Report.MemoryAfterBytes);
+
+        if (bReplaceSourceActors)
+        {
+            AStaticMeshActor* MergedActor = World->SpawnActor<AStaticMeshActor>(MergedLocation, FRotator::ZeroRotator);
+            if (MergedActor)
+            {
+                MergedActor->GetStaticMeshComponent()->SetStaticMesh(MergedMesh);
+                MergedActor->SetActorLabel(MergedMesh->GetName());
+
+                for (UStaticMeshComponent* Component : CellComponents)
+                {
+                    AActor* SourceActor = Component->GetOwner();
+                    SourceActor->Modify();
+                    World->EditorDestroyActor(SourceActor, true);
+                }
+            }
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("MergeLevelMeshesByCell: Cell (%d, %d) - %d actors, draws %d -> %d, memory %.2f MB -> %.2f MB"),
+            Report.Cell.X, Report.Cell.Y, Report.SourceActorCount, Report.DrawCallsBefore, Report.DrawCallsAfter,
+            Report.MemoryBeforeBytes / (1024.0f * 1024.0f), Report.MemoryAfterBytes / (1024.0f * 1024.0f));
+    }
+
+    // Drop the cells that failed to merge
+    Reports.RemoveAll([](const FMeshCellMergeReport& Report) { return Report.MergedMesh == nullptr; });
+
+    UE_LOG(LogTemp, Log, TEXT("MergeLevelMeshesByCell: Merged %d cells."), Reports.Num());
+    return Reports;
+}
+
+TArray<FNaniteMeshReport> UMeshTools::BatchEnableNanite(const FNaniteBatchOptions& Options)
+{
+    TOOLS_OPERATION_SCOPE("BatchEnableNanite");
+
+    TArray<FNaniteMeshReport> Reports;
+
+    if (!Options.Folder.StartsWith("/Game"))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("BatchEnableNanite: Invalid folder path '%s'. It must start with '/Game'."), *Options.Folder);
+        return Reports;
+    }
+
+    // Query every static mesh in the folder
+    FARFilter Filter;
     Filter.bRecursivePaths = true;
-    Filter.PackagePaths.Add("/Game");
+    Filter.PackagePaths.Add(FName(*Options.Folder));
+    Filter.ClassPaths.Add(UStaticMesh::StaticClass()->GetClassPathName());
+
+    ToolsOperationProfile.BeginPhase(TEXT("Registry Query"));
+    FToolsAssetRegistryCache::FAssetList MeshAssets = FToolsAssetRegistryCache::Get().GetAssets(Filter);
+    ToolsOperationProfile.EndPhase();
+    FToolsOperationProfile::CountAssetsScanned(MeshAssets->Num());
+
+    TArray<UStaticMesh*> MeshesToBuild;
+
+    ToolsOperationProfile.BeginPhase(TEXT("Load And Select"));
+    for (const FAssetData& Asset : *MeshAssets)
+    {
+        // Reject small meshes from the registry tag without loading them
+        int32 Triangles = 0;
+        if (Asset.GetTagValue(FName("Triangles"), Triangles) && Triangles < Options.MinTriangleCount)
+        {
+            continue;
+        }
+
+        UStaticMesh* Mesh = nullptr;
+        {
+            SCOPE_CYCLE_COUNTER(STAT_Tools_Load);
+            Mesh = Cast<UStaticMesh>(Asset.GetAsset());
+        }
+        if (!Mesh || Mesh->NaniteSettings.bEnabled)
+        {
+            continue;
+        }
+
+        Triangles = Mesh->GetNumTriangles(0);
+        if (Triangles < Options.MinTriangleCount)
+        {
+            continue;
+        }
+
+        // Nanite only renders opaque (and optionally masked) materials
+        bool bCompatible = true;
+        for (const FStaticMaterial& StaticMat : Mesh->GetStaticMaterials())
+        {
+            if (!StaticMat.MaterialInterface)
+            {
+                continue;
+            }
+
+            const EBlendMode BlendMode = StaticMat.MaterialInterface->GetBlendMode();
+            if (BlendMode != BLEND_Opaque && !(BlendMode == BLEND_Masked && Options.bAllowMaskedMaterials))
+            {
+                bCompatible = false;
+                break;
+            }
+        }
+
+        if (!bCompatible)
+        {
+            UE_LOG(LogTemp, Log, TEXT("BatchEnableNanite: Skipping %s, incompatible material blend mode."), *Mesh->GetName());
+            continue;
+        }
+
+        FNaniteMeshReport& Report = Reports.AddDefaulted_GetRef();
+        Report.Mesh = Mesh;
+        Report.Triangles = Triangles;
+        Report.DiskBytesBefore = MeshToolsPrivate::GetPackageFileSize(Mesh);
+        Report.MemoryBytesBefore = Mesh->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+
+        Mesh->Modify();
+        Mesh->NaniteSettings.bEnabled = true;
+        Mesh->NaniteSettings.FallbackTarget = Options.FallbackTarget;
+        Mesh->NaniteSettings.FallbackPercentTriangles = Options.FallbackPercentTriangles;
+        Mesh->NaniteSettings.FallbackRelativeError = Options.FallbackRelativeError;
+
+        if (Options.bClearHandMadeLODs)
+        {
+            Report.LODsRemoved = RemoveExtraSourceModels(Mesh);
+        }
+
+        MeshesToBuild.Add(Mesh);
+    }
+    ToolsOperationProfile.EndPhase();
+
+    if (MeshesToBuild.Num() == 0)
+    {
+        UE_LOG(LogTemp, Log, TEXT("BatchEnableNanite: No mesh matched the selection in %s."), *Options.Folder);
+        return Reports;
+    }
+
+    // One batched build for every selected mesh, then wait for the async compilation to finish
+    {
+        TOOLS_PHASE_SCOPE("Build", STAT_Tools_MeshBuild);
+        UStaticMesh::BatchBuild(MeshesToBuild, true);
+        FStaticMeshCompilingManager::Get().FinishCompilation(MeshesToBuild);
+        FToolsOperationProfile::CountBuilds(MeshesToBuild.Num());
+    }
+
+    int64 TotalDiskDelta = 0;
+    int64 TotalMemoryDelta = 0;
+
+    for (FNaniteMeshReport& Report : Reports)
+    {
+        // BatchBuild already rebuilt the mesh and refreshed its components, PostEditChange would build it again
+        UStaticMesh* Mesh = Report.Mesh;
+        Mesh->MarkPackageDirty();
+
+        {
+            TOOLS_PHASE_SCOPE("Save", STAT_Tools_Save);
+            if (!UEditorAssetLibrary::SaveLoadedAsset(Mesh))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("BatchEnableNanite: Failed to save mesh: %s"), *Mesh->GetPathName());
+            }
+            FToolsOperationProfile::CountSaves(1);
+        }
+
+        Report.DiskBytesAfter = MeshToolsPrivate::GetPackageFileSize(Mesh);
+        Report.MemoryBytesAfter = Mesh->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+
+        FToolsOperationProfile::CountBytesTouched(Report.DiskBytesAfter);
+        TotalDiskDelta += Report.DiskBytesAfter - Report.DiskBytesBefore;
+        TotalMemoryDelta += Report.MemoryBytesAfter - Report.MemoryBytesBefore;
+
+        UE_LOG(LogTemp, Log, TEXT("BatchEnableNanite: %s (%d triangles, %d LODs removed) disk %.2f MB -> %.2f MB, memory %.2f MB -> %.2f MB"),
+            *Mesh->GetName(), Report.Triangles, Report.LODsRemoved,
+            Report.DiskBytesBefore / (1024.0f * 1024.0f), Report.DiskBytesAfter / (1024.0f * 1024.0f),
+            Report.MemoryBytesBefore / (1024.0f * 1024.0f), Report.MemoryBytesAfter / (1024.0f * 1024.0f));
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("BatchEnableNanite: Converted %d meshes. Disk delta: %+.2f MB, memory delta: %+.2f MB"),
+        Reports.Num(), TotalDiskDelta / (1024.0f * 1024.0f), TotalMemoryDelta / (1024.0f * 1024.0f));
+
+    return Reports;
+}
+
+TArray<FMeshPrecisionReport> UMeshTools::ReduceVertexPrecision(const TArray<UStaticMesh*>& Meshes, float MaxUVErrorTexels, int32 ReferenceTextureSize, float MaxTangentErrorDegrees, bool bApply)
+{
+    TOOLS_OPERATION_SCOPE("ReduceVertexPrecision");
+
+    TArray<FMeshPrecisionReport> Reports;
+
+    for (UStaticMesh* Mesh : Meshes)
+    {
+        if (Mesh && Mesh->GetRenderData())
+        {
+            Reports.AddDefaulted_GetRef().Mesh = Mesh;
+        }
+    }
+
+    const int32 TextureSize = FMath::Max(ReferenceTextureSize, 1);
+    const float MaxUVError = MaxUVErrorTexels / TextureSize;
+    const float MinTangentCos = FMath::Cos(FMath::DegreesToRadians(MaxTangentErrorDegrees));
+
+    FToolsOperationProfile::CountAssetsScanned(Reports.Num());
+
+    // Measure every mesh on its CPU copy of the render data, one mesh per task
+    ToolsOperationProfile.BeginPhase(TEXT("Measure"));
+    ParallelFor(Reports.Num(), [&Reports, MaxUVError, MinTangentCos, TextureSize](int32 Index)
+    {
+        FMeshPrecisionReport& Report = Reports[Index];
+        const FStaticMeshRenderData* RenderData = Report.Mesh->GetRenderData();
+
+        bool bHasFullPrecisionUVs = false;
+        bool bHasHighPrecisionTangents = false;
+        float UVError = 0.0f;
+        float TangentMinCos = 1.0f;
+        int64 UVBytes = 0;
+        int64 TangentBytes = 0;
+
+        for (const FStaticMeshLODResources& LOD : RenderData->LODResources)
+        {
+            const FStaticMeshVertexBuffer& VertexBuffer = LOD.VertexBuffers.StaticMeshVertexBuffer;
+            const int64 NumVertices = VertexBuffer.GetNumVertices();
+            if (NumVertices == 0)
+            {
+                continue;
+            }
+
+            // UV channels are stored interleaved per vertex, the whole buffer is one float stream
+            if (VertexBuffer.GetUseFullPrecisionUVs() && VertexBuffer.GetTexCoordData())
+            {
+                const int64 NumUVs = NumVertices * VertexBuffer.GetNumTexCoords();
+                UVError = FMath::Max(UVError, MeshToolsPrivate::ComputeHalfPrecisionError(static_cast<const float*>(VertexBuffer.GetTexCoordData()), NumUVs * 2));
+                UVBytes += NumUVs * (sizeof(FVector2f) - sizeof(FVector2DHalf));
+                bHasFullPrecisionUVs = true;
+            }
+
+            // TangentX and TangentZ per vertex
+            if (VertexBuffer.GetUseHighPrecisionTangentBasis() && VertexBuffer.GetTangentData())
+            {
+                const int64 NumTangents = NumVertices * 2;
+                TangentMinCos = FMath::Min(TangentMinCos, MeshToolsPrivate::ComputeTangentQuantizationMinCos(static_cast<const FPackedRGBA16N*>(VertexBuffer.GetTangentData()), NumTangents));
+                TangentBytes += NumTangents * (sizeof(FPackedRGBA16N) - sizeof(FPackedNormal));
+                bHasHighPrecisionTangents = true;
+            }
+        }
+
+        Report.MaxUVErrorTexels = UVError * TextureSize;
+        Report.MaxTangentErrorDegrees = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(TangentMinCos, -1.0f, 1.0f)));
+        Report.bReducedUVs = bHasFullPrecisionUVs && UVError <= MaxUVError;
+        Report.bReducedTangents = bHasHighPrecisionTangents && TangentMinCos >= MinTangentCos;
+        Report.BytesSaved = (Report.bReducedUVs ? UVBytes : 0) + (Report.bReducedTangents ? TangentBytes : 0);
+    });
+    ToolsOperationProfile.EndPhase();
+
+    int64 TotalBytesSaved = 0;
+    TArray<UStaticMesh*> MeshesToBuild;
+
+    for (const FMeshPrecisionReport& Report : Reports)
+    {
+        UE_LOG(LogTemp, Log, TEXT("ReduceVertexPrecision: %s - UV error %.3f texels (%s), tangent error %.3f deg (%s), %.2f KB saved"),
+            *Report.Mesh->GetName(),
+            Report.MaxUVErrorTexels, Report.bReducedUVs ? TEXT("16-bit") : TEXT("kept"),
+            Report.MaxTangentErrorDegrees, Report.bReducedTangents ? TEXT("8-bit") : TEXT("kept"),
+            Report.BytesSaved / 1024.0f);
+
+        if (!Report.bReducedUVs && !Report.bReducedTangents)
+        {
+            continue;
+        }
+
+        TotalBytesSaved += Report.BytesSaved;
+
+        if (bApply)
+        {
+            UStaticMesh* Mesh = Report.Mesh;
+            Mesh->Modify();
+
+            for (int32 LODIndex = 0; LODIndex < Mesh->GetNumSourceModels(); ++LODIndex)
+            {
+                FMeshBuildSettings& BuildSettings = Mesh->GetSourceModel(LODIndex).BuildSettings;
+                if (Report.bReducedUVs)
+                {
+                    BuildSettings.bUseFullPrecisionUVs = false;
+                }
+                if (Report.bReducedTangents)
+                {
+                    BuildSettings.bUseHighPrecisionTangentBasis = false;
+                }
+            }
+
+            MeshesToBuild.Add(Mesh);
+        }
+    }
+
+    if (MeshesToBuild.Num() > 0)
+    {
+        {
+            TOOLS_PHASE_SCOPE("Build", STAT_Tools_MeshBuild);
+            UStaticMesh::BatchBuild(MeshesToBuild, true);
+            FStaticMeshCompilingManager::Get().FinishCompilation(MeshesToBuild);
+            FToolsOperationProfile::CountBuilds(MeshesToBuild.Num());
+        }
+
+        // No PostEditChange, the batched build is the only build
+        for (UStaticMesh* Mesh : MeshesToBuild)
+        {
+            Mesh->MarkPackageDirty();
+
+            TOOLS_PHASE_SCOPE("Save", STAT_Tools_Save);
+            if (!UEditorAssetLibrary::SaveLoadedAsset(Mesh))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("ReduceVertexPrecision: Failed to save mesh: %s"), *Mesh->GetPathName());
+            }
+            FToolsOperationProfile::CountSaves(1);
+            FToolsOperationProfile::CountBytesTouched(MeshToolsPrivate::GetPackageFileSize(Mesh));
+        }
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("ReduceVertexPrecision: %d of %d meshes %s. Vertex buffer memory saved: %.2f MB"),
+        Reports.FilterByPredicate([](const FMeshPrecisionReport& Report) { return Report.BytesSaved > 0; }).Num(), Reports.Num(),
+        bApply ? TEXT("reduced") : TEXT("reducible"), TotalBytesSaved / (1024.0f * 1024.0f));
+
+    return Reports;
+}
+
+TArray<FLightmapMeshReport> UMeshTools::AuditLightmapResolutions(const TArray<UStaticMesh*>& Meshes, const FLightmapBatchOptions& Options)
+{
+    using namespace MeshToolsPrivate;
+
+    TOOLS_OPERATION_SCOPE("AuditLightmapResolutions");
+
+    TArray<FLightmapMeshReport> Reports;
+    TMap<UStaticMesh*, int32> ReportIndices;
+
+    for (UStaticMesh* Mesh : Meshes)
+    {
+        if (Mesh && Mesh->GetRenderData() && !ReportIndices.Contains(Mesh))
+        {
+            ReportIndices.Add(Mesh, Reports.Num());
+            Reports.AddDefaulted_GetRef().Mesh = Mesh;
+        }
+    }
+
+    FToolsOperationProfile::CountAssetsScanned(Reports.Num());
+
+    // Placed instances: summed surface scale, and the memory of those with their own resolution
+    TArray<double> AreaScales;
+    TArray<int32> NumOverridden;
+    TArray<int64> OverriddenBytes;
+    AreaScales.SetNumZeroed(Reports.Num());
+    NumOverridden.SetNumZeroed(Reports.Num());
+    OverriddenBytes.SetNumZeroed(Reports.Num());
+    {
+        TOOLS_PHASE_SCOPE("Gather Instances", STAT_Tools_Analysis);
+        UWorld* World = GEditor->GetEditorWorldContext().World();
+        if (World)
+        {
+            for (TActorIterator<AStaticMeshActor> It(World); It; ++It)
+            {
+                const UStaticMeshComponent* Component = It->GetStaticMeshComponent();
+                if (!Component || Component->Mobility != EComponentMobility::Static)
+                    continue;
+
+                const int32* ReportIndex = ReportIndices.Find(Component->GetStaticMesh());
+                if (!ReportIndex)
+                    continue;
+
+                // A surface scales with the products of two axis scales
+                const FVector Scale = Component->GetComponentScale().GetAbs();
+                AreaScales[*ReportIndex] += (Scale.X * Scale.Y + Scale.Y * Scale.Z + Scale.Z * Scale.X) / 3.0;
+                ++Reports[*ReportIndex].NumInstances;
+
+                if (Component->bOverrideLightMapRes)
+                {
+                    ++NumOverridden[*ReportIndex];
+                    OverriddenBytes[*ReportIndex] += EstimateLightmapBytes(Component->OverriddenLightMapRes);
+                }
+            }
+        }
+    }
+
+    // Measure every mesh on its CPU copy of the render data, one mesh per task
+    TArray<double> MeshAreas;
+    MeshAreas.SetNumZeroed(Reports.Num());
+
+    ToolsOperationProfile.BeginPhase(TEXT("Measure"));
+    ParallelFor(Reports.Num(), [&Reports, &MeshAreas, &AreaScales](int32 Index)
+    {
+        FLightmapMeshReport& Report = Reports[Index];
+
+        double UVArea = 0.0;
+        MeasureLightmapCoverage(Report.Mesh, Report.Mesh->GetLightMapCoordinateIndex(), MeshAreas[Index], UVArea);
+
+        const double AreaScale = Report.NumInstances > 0 ? AreaScales[Index] / Report.NumInstances : 1.0;
+        Report.SurfaceAreaMeters = static_cast<float>(MeshAreas[Index] * AreaScale / (100.0 * 100.0));
+        Report.UVUtilization = static_cast<float>(UVArea);
+        Report.ResolutionBefore = Report.Mesh->GetLightMapResolution();
+    });
+    ToolsOperationProfile.EndPhase();
+
+    // Missing, overlapping or sparse lightmap UVs are generated again by the mesh build
+    TArray<UStaticMesh*> MeshesToBuild;
+    if (Options.bApply && Options.bRegenerateLightmapUVs)
+    {
+        for (FLightmapMeshReport& Report : Reports)
+        {
+            if (Report.UVUtilization >= Options.MinUVUtilization && Report.UVUtilization <= 1.0f)
+            {
+                continue;
+            }
+
+            UStaticMesh* Mesh = Report.Mesh;
+
+            // Reuse the lightmap channel only when the build already generates it, any other channel may hold texture coordinates
+            const int32 CurrentLightmapIndex = Mesh->GetLightMapCoordinateIndex();
+            const FMeshBuildSettings& CurrentSettings = Mesh->GetSourceModel(0).BuildSettings;
+            const bool bDedicatedChannel = CurrentLightmapIndex > 0 && CurrentSettings.bGenerateLightmapUVs && CurrentSettings.DstLightmapIndex == CurrentLightmapIndex;
+            const int32 DstLightmapIndex = bDedicatedChannel ? CurrentLightmapIndex : static_cast<int32>(Mesh->GetRenderData()->LODResources[0].VertexBuffers.StaticMeshVertexBuffer.GetNumTexCoords());
+
+            if (DstLightmapIndex >= MAX_STATIC_TEXCOORDS)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("AuditLightmapResolutions: %s has no free UV channel, lightmap UVs not regenerated."), *Mesh->GetName());
+                continue;
+            }
+
+            Mesh->Modify();
+
+            // Packing assumes the smallest resolution the charts can get, the padding stays wide enough
+            const int32 MinLightmapResolution = ProposeLightmapResolution(Report.SurfaceAreaMeters, 1.0, Options);
+
+            for (int32 LODIndex = 0; LODIndex < Mesh->GetNumSourceModels(); ++LODIndex)
+            {
+                FMeshBuildSettings& BuildSettings = Mesh->GetSourceModel(LODIndex).BuildSettings;
+                BuildSettings.bGenerateLightmapUVs = true;
+                BuildSettings.SrcLightmapIndex = 0;
+                BuildSettings.DstLightmapIndex = DstLightmapIndex;
+                BuildSettings.MinLightmapResolution = MinLightmapResolution;
+            }
+            Mesh->SetLightMapCoordinateIndex(DstLightmapIndex);
+
+            Report.bRegeneratedUVs = true;
+            MeshesToBuild.Add(Mesh);
+        }
+    }
+
+    if (MeshesToBuild.Num() > 0)
+    {
+        {
+            TOOLS_PHASE_SCOPE("Build", STAT_Tools_MeshBuild);
+            UStaticMesh::BatchBuild(MeshesToBuild, true);
+            FStaticMeshCompilingManager::Get().FinishCompilation(MeshesToBuild);
+            FToolsOperationProfile::CountBuilds(MeshesToBuild.Num());
+        }
+
+        ToolsOperationProfile.BeginPhase(TEXT("Measure"));
+        ParallelFor(Reports.Num(), [&Reports](int32 Index)
+        {
+            FLightmapMeshReport& Report = Reports[Index];
+            if (Report.bRegeneratedUVs)
+            {
+                double SurfaceArea = 0.0;
+                double UVArea = 0.0;
+                MeasureLightmapCoverage(Report.Mesh, Report.Mesh->GetLightMapCoordinateIndex(), SurfaceArea, UVArea);
+                Report.UVUtilization = static_cast<float>(UVArea);
+            }
+        });
+        ToolsOperationProfile.EndPhase();
+    }
 
-    // Use ClassPaths instead of deprecated ClassNames
-    // "/Script/Engine.Material" = UMaterial
-    // "/Script/Engine.MaterialInstanceConstant" = UMaterialInstanceConstant
-    Filter.ClassPaths.Add(FTopLevelAssetPath("/Script/Engine", "Material"));
-    Filter.ClassPaths.Add(FTopLevelAssetPath("/Script/Engine", "MaterialInstanceConstant"));
+    int64 TotalBytesBefore = 0;
+    int64 TotalBytesAfter = 0;
 
-    // Retrieve assets matching the filter
-    AssetRegistryModule.Get().GetAssets(Filter, OutAssets);
+    for (int32 Index = 0; Index < Reports.Num(); ++Index)
+    {
+        FLightmapMeshReport& Report = Reports[Index];
+
+        // Without lightmap UVs there is nothing to size the texture from
+        Report.ResolutionAfter = Report.UVUtilization > 0.0f ? ProposeLightmapResolution(Report.SurfaceAreaMeters, Report.UVUtilization, Options) : Report.ResolutionBefore;
+
+        const int32 NumUsingMesh = FMath::Max(Report.NumInstances, 1) - NumOverridden[Index];
+        Report.MemoryBytesBefore = OverriddenBytes[Index] + NumUsingMesh * EstimateLightmapBytes(Report.ResolutionBefore);
+        Report.MemoryBytesAfter = OverriddenBytes[Index] + NumUsingMesh * EstimateLightmapBytes(Report.ResolutionAfter);
+        TotalBytesBefore += Report.MemoryBytesBefore;
+        TotalBytesAfter += Report.MemoryBytesAfter;
+
+        UE_LOG(LogTemp, Log, TEXT("AuditLightmapResolutions: %s - %.2f m2, UV utilization %.2f%s, %d instances, resolution %d -> %d, %.2f MB -> %.2f MB"),
+            *Report.Mesh->GetName(), Report.SurfaceAreaMeters, Report.UVUtilization, Report.bRegeneratedUVs ? TEXT(" (regenerated)") : TEXT(""),
+            Report.NumInstances, Report.ResolutionBefore, Report.ResolutionAfter,
+            Report.MemoryBytesBefore / (1024.0f * 1024.0f), Report.MemoryBytesAfter / (1024.0f * 1024.0f));
+
+        if (!Options.bApply || (Report.ResolutionAfter == Report.ResolutionBefore && !Report.bRegeneratedUVs))
+        {
+            continue;
+        }
+
+        // The resolution is only read by the lighting build, and regenerated UVs were built by the batched build
+        UStaticMesh* Mesh = Report.Mesh;
+        Mesh->Modify();
+        Mesh->SetLightMapResolution(Report.ResolutionAfter);
+        Mesh->MarkPackageDirty();
+
+        TOOLS_PHASE_SCOPE("Save", STAT_Tools_Save);
+        if (!UEditorAssetLibrary::SaveLoadedAsset(Mesh))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("AuditLightmapResolutions: Failed to save mesh: %s"), *Mesh->GetPathName());
+        }
+        FToolsOperationProfile::CountSaves(1);
+        FToolsOperationProfile::CountBytesTouched(GetPackageFileSize(Mesh));
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("AuditLightmapResolutions: %d meshes, %d UVs regenerated. Projected lightmap memory: %.2f MB -> %.2f MB"),
+        Reports.Num(), MeshesToBuild.Num(), TotalBytesBefore / (1024.0f * 1024.0f), TotalBytesAfter / (1024.0f * 1024.0f));
+
+    return Reports;
+}
+
+int32 UMeshTools::ReplaceMaterialBatch(const TArray<UObject*>& Objects, const FString& MaterialToReplaceName, const FString& NewMaterialName)
+{
+    TOOLS_OPERATION_SCOPE("ReplaceMaterialBatch");
+
+    // Materials are resolved through the shared registry cache, repeated calls skip the lookup
+    FToolsAssetRegistryCache& RegistryCache = FToolsAssetRegistryCache::Get();
+
+    // Construct the full object path for the new material
+    FString NewMaterialObjectPath = FString::Printf(TEXT("/Game/%s.%s"), *NewMaterialName, *NewMaterialName);
+    FAssetData NewMaterialData;
+    {
+        TOOLS_PHASE_SCOPE("Registry Query", STAT_Tools_RegistryQuery);
+        NewMaterialData = RegistryCache.GetAssetByObjectPath(FSoftObjectPath(NewMaterialObjectPath));
+    }
+    UMaterialInterface* NewMaterial = Cast<UMaterialInterface>(NewMaterialData.GetAsset());
+
+    if (!NewMaterial)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ReplaceMaterialBatch: Failed to find NewMaterial '%s'. Aborting."), *NewMaterialObjectPath);
+        return 0;
+    }
+
+    // Optionally resolve MaterialToReplace (can be empty)
+    UMaterialInterface* MaterialToReplace = nullptr;
+    if (!MaterialToReplaceName.IsEmpty())
+    {
+        FString OldMaterialObjectPath = FString::Printf(TEXT("/Game/%s.%s"), *MaterialToReplaceName, *MaterialToReplaceName);
+        FAssetData OldMaterialData = RegistryCache.GetAssetByObjectPath(FSoftObjectPath(OldMaterialObjectPath));
+        MaterialToReplace = Cast<UMaterialInterface>(OldMaterialData.GetAsset());
+
+        if (!MaterialToReplace)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("ReplaceMaterialBatch: Could not find MaterialToReplace '%s'. Continuing with global replacement."), *OldMaterialObjectPath);
+        }
+    }
+
+    FToolsOperationProfile::CountAssetsScanned(Objects.Num());
+
+    TArray<UStaticMesh*> Meshes;
+    for (UObject* Obj : Objects)
+    {
+        UStaticMesh* Mesh = Cast<UStaticMesh>(Obj);
+        if (!Mesh)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("ReplaceMaterialBatch: Skipping non-UStaticMesh object."));
+            continue;
+        }
+
+        Meshes.Add(Mesh);
+    }
+
+    // Without MaterialToReplace the null key matches every slot
+    TMap<UMaterialInterface*, UMaterialInterface*> Replacements;
+    Replacements.Add(MaterialToReplace, NewMaterial);
+    const int32 ModifiedCount = ReplaceMaterialsOnMeshes(Meshes, Replacements);
+
+    UE_LOG(LogTemp, Log, TEXT("ReplaceMaterialBatch: Modified %d meshes."), ModifiedCount);
+    return ModifiedCount;
+}
+
+int32 UMeshTools::ReplaceMaterialsOnMeshes(const TArray<UStaticMesh*>& Meshes, const TMap<UMaterialInterface*, UMaterialInterface*>& Replacements)
+{
+    auto FindReplacement = [&Replacements](UMaterialInterface* Current) -> UMaterialInterface*
+    {
+        UMaterialInterface* const* Replacement = Replacements.Find(Current);
+        if (!Replacement)
+        {
+            Replacement = Replacements.Find(nullptr);
+        }
+        return Replacement && *Replacement != Current ? *Replacement : nullptr;
+    };
+
+    TSet<UStaticMesh*> ModifiedMeshes;
+
+    for (UStaticMesh* Mesh : Meshes)
+    {
+        bool bModified = false;
+        TArray<FStaticMaterial>& StaticMaterials = Mesh->GetStaticMaterials();
+
+        // Replace materials on the static mesh asset
+        for (FStaticMaterial& StaticMat : StaticMaterials)
+        {
+            if (UMaterialInterface* Replacement = FindReplacement(StaticMat.MaterialInterface))
+            {
+                StaticMat.MaterialInterface = Replacement;
+                bModified = true;
+            }
+        }
+
+        if (!bModified)
+        {
+            continue;
+        }
+
+        // Mark asset dirty and save
+        Mesh->MarkPackageDirty();
+
+        const FString AssetPath = Mesh->GetPathName();
+        bool bSaved = false;
+        {
+            TOOLS_PHASE_SCOPE("Save", STAT_Tools_Save);
+            bSaved = UEditorAssetLibrary::SaveAsset(AssetPath);
+            FToolsOperationProfile::CountSaves(1);
+        }
+
+        if (!bSaved)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("ReplaceMaterialsOnMeshes: Failed to save modified mesh: %s"), *AssetPath);
+        }
+
+        ModifiedMeshes.Add(Mesh);
+    }
+
+    if (ModifiedMeshes.Num() == 0)
+    {
+        return 0;
+    }
 
-    return OutAssets;
+    // Update materials on all actors in the scene using a modified mesh, in one pass over the level
+    TOOLS_PHASE_SCOPE("Update Actors", STAT_Tools_Analysis);
+    UWorld* World = GEditor->GetEditorWorldContext().World();
+    if (World)
+    {
+        for (TActorIterator<AStaticMeshActor> It(World); It; ++It)
+        {
+            AStaticMeshActor* Actor = *It;
+            if (!Actor || !Actor->GetStaticMeshComponent())
+                continue;
+
+            UStaticMeshComponent* Component = Actor->GetStaticMeshComponent();
+            if (!ModifiedMeshes.Contains(Component->GetStaticMesh()))
+                continue;
+
+            Actor->Modify(); // Allow undo
+
+            int32 MatCount = Component->GetNumMaterials();
+            for (int32 i = 0; i < MatCount; ++i)
+            {
+                if (UMaterialInterface* Replacement = FindReplacement(Component->GetMaterial(i)))
+                {
+                    Component->SetMaterial(i, Replacement);
+                }
+            }
+
+            // Force the render state to update so material changes appear immediately
+            Component->MarkRenderStateDirty();
+        }
+    }
+
+    return ModifiedMeshes.Num();
+}
+
+TArray<FAssetData> UMeshTools::GetAllMaterialAssets()
+{
+    // Retrieve assets matching the filter, shared with every other tool querying materials
+    FToolsAssetRegistryCache::FAssetList MaterialAssets = FToolsAssetRegistryCache::Get().GetAssets(MeshToolsPrivate::MakeMaterialFilter());
+    FToolsOperationProfile::CountAssetsScanned(MaterialAssets->Num());
+
+    return *MaterialAssets;
 }
 
 TArray<FString> UMeshTools::GetAllMaterialAssetNames(const FString& NameFilter)
 {
     TArray<FString> MaterialNames;
 
-    // Get all material and material instance assets
-    TArray<FAssetData> MaterialAssets = GetAllMaterialAssets();
+    // Get all material and material instance assets, without copying the cached list
+    FToolsAssetRegistryCache::FAssetList MaterialAssets = FToolsAssetRegistryCache::Get().GetAssets(MeshToolsPrivate::MakeMaterialFilter());
 
-    for (const FAssetData& Asset : MaterialAssets)
+    for (const FAssetData& Asset : *MaterialAssets)
     {
         const FString AssetName = Asset.AssetName.ToString();
 
@@ -276,3 +1478,333 @@ TArray<FString> UMeshTools::GetAllMaterialAssetNames(const FString& NameFilter)
 
     return MaterialNames;
 }
+
+TArray<FMaterialInstanceDuplicateGroup> UMeshTools::FindDuplicateMaterialInstances(const FString& Folder, TArray<FMaterialPermutationReport>& OutPermutations)
+{
+    using namespace MeshToolsPrivate;
+
+    TOOLS_OPERATION_SCOPE("FindDuplicateMaterialInstances");
+
+    OutPermutations.Reset();
+
+    FARFilter Filter;
+    Filter.bRecursivePaths = true;
+    Filter.PackagePaths.Add(FName(*Folder));
+    Filter.ClassPaths.Add(UMaterialInstanceConstant::StaticClass()->GetClassPathName());
+
+    FToolsAssetRegistryCache& RegistryCache = FToolsAssetRegistryCache::Get();
+
+    ToolsOperationProfile.BeginPhase(TEXT("Registry Query"));
+    FToolsAssetRegistryCache::FAssetList Assets = RegistryCache.GetAssets(Filter);
+    ToolsOperationProfile.EndPhase();
+    FToolsOperationProfile::CountAssetsScanned(Assets->Num());
+
+    struct FInstanceEntry
+    {
+        FString Path;
+        FName Package;
+        FString Parent;
+        FString BaseMaterial;
+        FString StaticSignature;
+        FString ParameterSignature;
+        bool bStaticPermutation = false;
+    };
+
+    // Resolved values need the loaded instances, read them on the game thread in batches
+    TArray<FInstanceEntry> Entries;
+    Entries.Reserve(Assets->Num());
+    TMap<FString, FString> BaseSignatures;
+    TMap<FString, int32> BaseUsages;
+
+    for (int32 BatchStart = 0; BatchStart < Assets->Num(); BatchStart += MaterialInstanceBatchSize)
+    {
+        const int32 BatchEnd = FMath::Min(BatchStart + MaterialInstanceBatchSize, Assets->Num());
+        {
+            TOOLS_PHASE_SCOPE("Read Parameters", STAT_Tools_Load);
+            for (int32 Index = BatchStart; Index < BatchEnd; ++Index)
+            {
+                UMaterialInstanceConstant* Instance = Cast<UMaterialInstanceConstant>((*Assets)[Index].GetAsset());
+                UMaterial* BaseMaterial = Instance && Instance->Parent ? Instance->GetMaterial() : nullptr;
+                if (!BaseMaterial)
+                {
+                    continue;
+                }
+
+                const FString BasePath = BaseMaterial->GetPathName();
+                if (!BaseSignatures.Contains(BasePath))
+                {
+                    BaseSignatures.Add(BasePath, MakeStaticSignature(BaseMaterial));
+                    BaseUsages.Add(BasePath, CountMaterialUsages(BaseMaterial));
+                }
+
+                // Instances without static permutation render with the shader map of the base material
+                FInstanceEntry& Entry = Entries.AddDefaulted_GetRef();
+                Entry.Path = Instance->GetPathName();
+                Entry.Package = (*Assets)[Index].PackageName;
+                Entry.Parent = Instance->Parent->GetPathName();
+                Entry.BaseMaterial = BasePath;
+                Entry.bStaticPermutation = Instance->bHasStaticPermutationResource;
+                Entry.StaticSignature = Entry.bStaticPermutation ? MakeStaticSignature(Instance) : BaseSignatures[BasePath];
+                Entry.ParameterSignature = MakeParameterSignature(Instance);
+            }
+        }
+
+        if (IsRunningCommandlet())
+        {
+            TOOLS_PHASE_SCOPE("Garbage Collection", STAT_Tools_Load);
+            CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+        }
+    }
+
+    ToolsOperationProfile.BeginPhase(TEXT("Group Instances"));
+
+    // Same parent, same permutation and same resolved values render the same
+    TMap<FString, TArray<int32>> EntriesByKey;
+    for (int32 Index = 0; Index < Entries.Num(); ++Index)
+    {
+        const FInstanceEntry& Entry = Entries[Index];
+        EntriesByKey.FindOrAdd(FString::Printf(TEXT("%s|%s|%s"), *Entry.Parent, *Entry.StaticSignature, *Entry.ParameterSignature)).Add(Index);
+    }
+
+    struct FBaseStats
+    {
+        int32 NumInstances = 0;
+        int32 NumStaticPermutationInstances = 0;
+        TMap<FString, int32> SignatureUses;
+        int32 DuplicateInstances = 0;
+        int32 DuplicateStaticPermutationInstances = 0;
+    };
+
+    TMap<FString, FBaseStats> StatsByBase;
+    for (const FInstanceEntry& Entry : Entries)
+    {
+        FBaseStats& Stats = StatsByBase.FindOrAdd(Entry.BaseMaterial);
+        ++Stats.NumInstances;
+        if (Entry.bStaticPermutation)
+        {
+            ++Stats.NumStaticPermutationInstances;
+            ++Stats.SignatureUses.FindOrAdd(Entry.StaticSignature);
+        }
+    }
+
+    TArray<FMaterialInstanceDuplicateGroup> Groups;
+    for (TPair<FString, TArray<int32>>& Pair : EntriesByKey)
+    {
+        TArray<int32>& Members = Pair.Value;
+        if (Members.Num() < 2)
+        {
+            continue;
+        }
+
+        // Keep the most referenced instance, the fewest assets get retargeted
+        TMap<int32, int32> NumReferencers;
+        for (int32 Member : Members)
+        {
+            NumReferencers.Add(Member, RegistryCache.GetReferencers(Entries[Member].Package).Num());
+        }
+        Members.Sort([&Entries, &NumReferencers](int32 A, int32 B)
+        {
+            return NumReferencers[A] != NumReferencers[B] ? NumReferencers[A] > NumReferencers[B] : Entries[A].Path < Entries[B].Path;
+        });
+
+        FMaterialInstanceDuplicateGroup& Group = Groups.AddDefaulted_GetRef();
+        Group.Parent = Entries[Members[0]].Parent;
+        Group.StaticSignature = Entries[Members[0]].StaticSignature;
+
+        FBaseStats& Stats = StatsByBase[Entries[Members[0]].BaseMaterial];
+        for (int32 MemberIndex = 0; MemberIndex < Members.Num(); ++MemberIndex)
+        {
+            const FInstanceEntry& Entry = Entries[Members[MemberIndex]];
+            Group.Instances.Add(Entry.Path);
+
+            if (MemberIndex > 0)
+            {
+                ++Stats.DuplicateInstances;
+                Stats.DuplicateStaticPermutationInstances += Entry.bStaticPermutation ? 1 : 0;
+            }
+        }
+    }
+
+    for (const TPair<FString, FBaseStats>& Pair : StatsByBase)
+    {
+        const FBaseStats& Stats = Pair.Value;
+        const FString& BaseSignature = BaseSignatures[Pair.Key];
+
+        FMaterialPermutationReport& Report = OutPermutations.AddDefaulted_GetRef();
+        Report.BaseMaterial = Pair.Key;
+        Report.NumInstances = Stats.NumInstances;
+        Report.NumStaticPermutationInstances = Stats.NumStaticPermutationInstances;
+        Report.UniqueStaticPermutations = Stats.SignatureUses.Num() + (Stats.SignatureUses.Contains(BaseSignature) ? 0 : 1);
+        Report.NumUsages = BaseUsages[Pair.Key];
+        Report.EstimatedPermutations = Report.UniqueStaticPermutations * Report.NumUsages;
+        Report.EstimatedShaderMaps = 1 + Stats.NumStaticPermutationInstances;
+        Report.EstimatedShaderMapsAfterConsolidation = Report.EstimatedShaderMaps - Stats.DuplicateStaticPermutationInstances;
+        Report.DuplicateInstances = Stats.DuplicateInstances;
+
+        for (const TPair<FString, int32>& Use : Stats.SignatureUses)
+        {
+            Report.SingleUseStaticPermutations += Use.Value == 1 && Use.Key != BaseSignature ? 1 : 0;
+        }
+    }
+
+    ToolsOperationProfile.EndPhase();
+
+    Groups.Sort([](const FMaterialInstanceDuplicateGroup& A, const FMaterialInstanceDuplicateGroup& B)
+    {
+        return A.Instances.Num() > B.Instances.Num();
+    });
+    OutPermutations.Sort([](const FMaterialPermutationReport& A, const FMaterialPermutationReport& B)
+    {
+        return A.EstimatedPermutations > B.EstimatedPermutations;
+    });
+
+    UE_LOG(LogTemp, Log, TEXT("FindDuplicateMaterialInstances: %d instances, %d duplicate groups over %d base materials"), Entries.Num(), Groups.Num(), OutPermutations.Num());
+    return Groups;
+}
+
+int32 UMeshTools::ConsolidateDuplicateMaterialInstances(const TArray<FMaterialInstanceDuplicateGroup>& Groups, bool bDeleteDuplicates)
+{
+    TOOLS_OPERATION_SCOPE("ConsolidateDuplicateMaterialInstances");
+
+    // Every duplicate of every group mapped to its keeper, so each mesh is saved once
+    TMap<UMaterialInterface*, UMaterialInterface*> Replacements;
+    {
+        TOOLS_PHASE_SCOPE("Load Instances", STAT_Tools_Load);
+        for (const FMaterialInstanceDuplicateGroup& Group : Groups)
+        {
+            if (Group.Instances.Num() < 2)
+            {
+                continue;
+            }
+
+            UMaterialInterface* Keeper = Cast<UMaterialInterface>(UEditorAssetLibrary::LoadAsset(Group.Instances[0]));
+            if (!Keeper)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("ConsolidateDuplicateMaterialInstances: Failed to load %s, skipping group."), *Group.Instances[0]);
+                continue;
+            }
+
+            for (int32 Index = 1; Index < Group.Instances.Num(); ++Index)
+            {
+                UMaterialInterface* Duplicate = Cast<UMaterialInterface>(UEditorAssetLibrary::LoadAsset(Group.Instances[Index]));
+                if (Duplicate && Duplicate != Keeper)
+                {
+                    Replacements.Add(Duplicate, Keeper);
+                }
+            }
+        }
+    }
+
+    if (Replacements.Num() == 0)
+    {
+        return 0;
+    }
+
+    FToolsAssetRegistryCache& RegistryCache = FToolsAssetRegistryCache::Get();
+
+    // Meshes and derived instances are retargeted here, anything else keeps its duplicate alive
+    TArray<UStaticMesh*> Meshes;
+    TArray<UMaterialInstanceConstant*> Children;
+    TMap<FName, TArray<UMaterialInterface*>> DuplicatesByReferencer;
+    TSet<UMaterialInterface*> StillReferenced;
+    {
+        TOOLS_PHASE_SCOPE("Find Referencers", STAT_Tools_RegistryQuery);
+        for (const TPair<UMaterialInterface*, UMaterialInterface*>& Pair : Replacements)
+        {
+            for (const FName Referencer : RegistryCache.GetReferencers(Pair.Key->GetOutermost()->GetFName()))
+            {
+                TArray<UMaterialInterface*>* Duplicates = DuplicatesByReferencer.Find(Referencer);
+                if (Duplicates)
+                {
+                    Duplicates->Add(Pair.Key);
+                    continue;
+                }
+
+                bool bHandled = false;
+                for (const FAssetData& Asset : *RegistryCache.GetAssetsByPackageName(Referencer))
+                {
+                    if (Asset.IsInstanceOf(UStaticMesh::StaticClass()))
+                    {
+                        if (UStaticMesh* Mesh = Cast<UStaticMesh>(Asset.GetAsset()))
+                        {
+                            Meshes.Add(Mesh);
+                            bHandled = true;
+                        }
+                    }
+                    else if (Asset.IsInstanceOf(UMaterialInstanceConstant::StaticClass()))
+                    {
+                        // Duplicates too: one still referenced elsewhere survives the deletion of its parent
+                        UMaterialInstanceConstant* Child = Cast<UMaterialInstanceConstant>(Asset.GetAsset());
+                        if (Child)
+                        {
+                            Children.Add(Child);
+                        }
+                        bHandled = Child != nullptr;
+                    }
+                }
+
+                if (bHandled)
+                {
+                    DuplicatesByReferencer.Add(Referencer).Add(Pair.Key);
+                }
+                else
+                {
+                    UE_LOG(LogTemp, Log, TEXT("ConsolidateDuplicateMaterialInstances: %s is still referenced by %s"), *Pair.Key->GetName(), *Referencer.ToString());
+                    StillReferenced.Add(Pair.Key);
+                }
+            }
+        }
+    }
+    FToolsOperationProfile::CountAssetsScanned(Replacements.Num() + Meshes.Num() + Children.Num());
+
+    for (UMaterialInstanceConstant* Child : Children)
+    {
+        UMaterialInterface* const* NewParent = Replacements.Find(Child->Parent.Get());
+        if (!NewParent)
+        {
+            continue;
+        }
+
+        Child->SetParentEditorOnly(*NewParent);
+        Child->PostEditChange();
+        Child->MarkPackageDirty();
+
+        TOOLS_PHASE_SCOPE("Save", STAT_Tools_Save);
+        if (!UEditorAssetLibrary::SaveAsset(Child->GetPathName()))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("ConsolidateDuplicateMaterialInstances: Failed to save reparented instance: %s"), *Child->GetPathName());
+        }
+        FToolsOperationProfile::CountSaves(1);
+    }
+
+    const int32 ModifiedMeshes = ReplaceMaterialsOnMeshes(Meshes, Replacements);
+
+    // A referencer left unsaved still points to the duplicates on disk
+    for (const TPair<FName, TArray<UMaterialInterface*>>& Pair : DuplicatesByReferencer)
+    {
+        const UPackage* Package = FindPackage(nullptr, *Pair.Key.ToString());
+        if (Package && Package->IsDirty())
+        {
+            StillReferenced.Append(Pair.Value);
+        }
+    }
+
+    TArray<UObject*> Unreferenced;
+    for (const TPair<UMaterialInterface*, UMaterialInterface*>& Pair : Replacements)
+    {
+        if (!StillReferenced.Contains(Pair.Key))
+        {
+            Unreferenced.Add(Pair.Key);
+        }
+    }
+
+    const int32 NumUnreferenced = Unreferenced.Num();
+    if (bDeleteDuplicates && NumUnreferenced > 0)
+    {
+        TOOLS_PHASE_SCOPE("Delete", STAT_Tools_Save);
+        ObjectTools::DeleteObjects(Unreferenced, false);
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("ConsolidateDuplicateMaterialInstances: %d meshes and %d instances retargeted, %d of %d duplicates unreferenced"), ModifiedMeshes, Children.Num(), NumUnreferenced, Replacements.Num());
+    return NumUnreferenced;
+}
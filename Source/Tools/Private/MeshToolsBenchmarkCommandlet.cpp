@@ -0,0 +1,364 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MeshToolsBenchmarkCommandlet.h"
+#include "MeshTools.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInterface.h"
+#include "StaticMeshAttributes.h"
+#include "MeshDescription.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "EditorAssetLibrary.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformProcess.h"
+#include "Async/Async.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "JsonObjectConverter.h"
+#include "UObject/Package.h"
+#include <atomic>
+
+#define BENCHMARK_FOLDER TEXT("/Game/_MeshToolsBenchmark")
+
+namespace MeshToolsBenchmarkPrivate
+{
+    /** Below this, time differences are scheduler noise rather than regressions */
+    constexpr double MinSecondsDelta = 0.05;
+    constexpr double MinMemoryDeltaMB = 16.0;
+
+    /** Interval between two memory samples while an operation runs */
+    constexpr float MemorySampleSeconds = 0.002f;
+
+    /** Runs one operation and records its time and how far used memory rose above its level right before it */
+    template<typename FunctorType>
+    FMeshToolsBenchmarkResult Measure(const TCHAR* Operation, int32 Triangles, FunctorType&& Functor)
+    {
+        // The process high-water mark can't be reset, so sample used memory on the side instead
+        const uint64 StartUsed = FPlatformMemory::GetStats().UsedPhysical;
+        std::atomic<bool> bDone(false);
+        TFuture<uint64> PeakUsed = Async(EAsyncExecution::Thread, [&bDone, StartUsed]()
+        {
+            uint64 Peak = StartUsed;
+            while (!bDone.load(std::memory_order_relaxed))
+            {
+                Peak = FMath::Max<uint64>(Peak, FPlatformMemory::GetStats().UsedPhysical);
+                FPlatformProcess::Sleep(MemorySampleSeconds);
+            }
+            return Peak;
+        });
+
+        const double StartSeconds = FPlatformTime::Seconds();
+
+        Functor();
+
+        FMeshToolsBenchmarkResult Result;
+        Result.Seconds = FPlatformTime::Seconds() - StartSeconds;
+
+        bDone = true;
+        const uint64 Peak = FMath::Max<uint64>(PeakUsed.Get(), FPlatformMemory::GetStats().UsedPhysical);
+        Result.PeakMemoryMB = (Peak - StartUsed) / (1024.0 * 1024.0);
+
+        Result.Operation = Operation;
+        Result.Triangles = Triangles;
+        return Result;
+    }
+
+    int32 GetNumTriangles(const UStaticMesh* Mesh, int32 LODIndex)
+    {
+        const FStaticMeshRenderData* RenderData = Mesh->GetRenderData();
+        return RenderData && RenderData->LODResources.IsValidIndex(LODIndex) ? RenderData->LODResources[LODIndex].GetNumTriangles() : 0;
+    }
+
+    bool LoadResults(const FString& FilePath, TArray<FMeshToolsBenchmarkResult>& OutResults)
+    {
+        FString Json;
+        if (!FFileHelper::LoadFileToString(Json, *FilePath))
+        {
+            return false;
+        }
+
+        return FJsonObjectConverter::JsonArrayStringToUStruct(Json, &OutResults);
+    }
+
+    bool SaveResults(const FString& FilePath, const TArray<FMeshToolsBenchmarkResult>& Results)
+    {
+        TArray<TSharedPtr<FJsonValue>> JsonResults;
+        for (const FMeshToolsBenchmarkResult& Result : Results)
+        {
+            JsonResults.Add(MakeShared<FJsonValueObject>(FJsonObjectConverter::UStructToJsonObject(Result)));
+        }
+
+        FString Output;
+        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+        return FJsonSerializer::Serialize(JsonResults, Writer) && FFileHelper::SaveStringToFile(Output, *FilePath);
+    }
+
+    /** Logs and counts the measurements that got worse than their baseline by more than the tolerances */
+    int32 CompareToBaseline(const TArray<FMeshToolsBenchmarkResult>& Results, const TArray<FMeshToolsBenchmarkResult>& Baseline,
+        double TimeTolerance, double MemoryTolerance, double QualityTolerance)
+    {
+        int32 NumRegressions = 0;
+
+        for (const FMeshToolsBenchmarkResult& Result : Results)
+        {
+            const FMeshToolsBenchmarkResult* Reference = Baseline.FindByPredicate([&Result](const FMeshToolsBenchmarkResult& Candidate)
+            {
+                return Candidate.Operation == Result.Operation && Candidate.Triangles == Result.Triangles;
+            });
+
+            if (!Reference)
+            {
+                UE_LOG(LogTemp, Display, TEXT("MeshToolsBenchmark: No baseline for %s at %d triangles."), *Result.Operation, Result.Triangles);
+                continue;
+            }
+
+            if (Result.Seconds > Reference->Seconds * (1.0 + TimeTolerance) && Result.Seconds - Reference->Seconds > MinSecondsDelta)
+            {
+                UE_LOG(LogTemp, Error, TEXT("MeshToolsBenchmark: %s at %d triangles took %.3f s, baseline %.3f s."),
+                    *Result.Operation, Result.Triangles, Result.Seconds, Reference->Seconds);
+                ++NumRegressions;
+            }
+
+            if (Result.PeakMemoryMB > Reference->PeakMemoryMB * (1.0 + MemoryTolerance) && Result.PeakMemoryMB - Reference->PeakMemoryMB > MinMemoryDeltaMB)
+            {
+                UE_LOG(LogTemp, Error, TEXT("MeshToolsBenchmark: %s at %d triangles peaked at %.1f MB, baseline %.1f MB."),
+                    *Result.Operation, Result.Triangles, Result.PeakMemoryMB, Reference->PeakMemoryMB);
+                ++NumRegressions;
+            }
+
+            // Quality is checked both ways: fewer hull vertices or a different LOD ratio both change the output
+            const double QualityScale = FMath::Max(FMath::Abs(Reference->Quality), 1.0);
+            if (FMath::Abs(Result.Quality - Reference->Quality) > QualityTolerance * QualityScale)
+            {
+                UE_LOG(LogTemp, Error, TEXT("MeshToolsBenchmark: %s at %d triangles has %s %.3f, baseline %.3f."),
+                    *Result.Operation, Result.Triangles, *Result.QualityMetric, Result.Quality, Reference->Quality);
+                ++NumRegressions;
+            }
+        }
+
+        return NumRegressions;
+    }
+}
+
+UMeshToolsBenchmarkCommandlet::UMeshToolsBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+UStaticMesh* UMeshToolsBenchmarkCommandlet::CreateSyntheticMesh(const FString& PackageName, int32 TargetTriangles)
+{
+    // A UV sphere has about 2 * Rings * Segments triangles, with twice as many segments as rings
+    const int32 Rings = FMath::Max(FMath::RoundToInt(FMath::Sqrt(TargetTriangles / 4.0)), 2);
+    const int32 Segments = Rings * 2;
+    const float Radius = 100.0f;
+
+    UPackage* Package = CreatePackage(*PackageName);
+    UStaticMesh* Mesh = NewObject<UStaticMesh>(Package, *FPackageName::GetShortName(PackageName), RF_Public | RF_Standalone | RF_Transactional);
+    Mesh->GetStaticMaterials().Add(FStaticMaterial(nullptr, FName("Benchmark"), FName("Benchmark")));
+
+    FStaticMeshSourceModel& SourceModel = Mesh->AddSourceModel();
+    SourceModel.BuildSettings.bRecomputeNormals = false;
+    SourceModel.BuildSettings.bRecomputeTangents = true;
+
+    FMeshDescription* MeshDescription = Mesh->CreateMeshDescription(0);
+    FStaticMeshAttributes Attributes(*MeshDescription);
+    Attributes.Register();
+
+    TVertexAttributesRef<FVector3f> Positions = Attributes.GetVertexPositions();
+    TVertexInstanceAttributesRef<FVector3f> Normals = Attributes.GetVertexInstanceNormals();
+    TVertexInstanceAttributesRef<FVector2f> UVs = Attributes.GetVertexInstanceUVs();
+    TPolygonGroupAttributesRef<FName> SlotNames = Attributes.GetPolygonGroupMaterialSlotNames();
+
+    const int32 NumVertices = (Rings + 1) * (Segments + 1);
+    MeshDescription->ReserveNewVertices(NumVertices);
+    MeshDescription->ReserveNewVertexInstances(NumVertices);
+    MeshDescription->ReserveNewTriangles(2 * Rings * Segments);
+
+    const FPolygonGroupID PolygonGroup = MeshDescription->CreatePolygonGroup();
+    SlotNames[PolygonGroup] = FName("Benchmark");
+
+    // One shared instance per vertex, the seam column is duplicated for the UVs
+    TArray<FVertexInstanceID> Instances;
+    Instances.SetNumUninitialized(NumVertices);
+    for (int32 Ring = 0; Ring <= Rings; ++Ring)
+    {
+        const float Theta = UE_PI * Ring / Rings;
+        for (int32 Segment = 0; Segment <= Segments; ++Segment)
+        {
+            const float Phi = UE_TWO_PI * Segment / Segments;
+            const FVector3f Direction(FMath::Sin(Theta) * FMath::Cos(Phi), FMath::Sin(Theta) * FMath::Sin(Phi), FMath::Cos(Theta));
+
+            // Bumps so the hull and the reduction have something to work with
+            const float Displacement = 1.0f + 0.05f * FMath::Sin(7.0f * Theta) * FMath::Cos(5.0f * Phi);
+
+            const FVertexID Vertex = MeshDescription->CreateVertex();
+            Positions[Vertex] = Direction * Radius * Displacement;
+
+            const FVertexInstanceID Instance = MeshDescription->CreateVertexInstance(Vertex);
+            Normals[Instance] = Direction;
+            UVs[Instance] = FVector2f(float(Segment) / Segments, float(Ring) / Rings);
+            Instances[Ring * (Segments + 1) + Segment] = Instance;
+        }
+    }
+
+    for (int32 Ring = 0; Ring < Rings; ++Ring)
+    {
+        for (int32 Segment = 0; Segment < Segments; ++Segment)
+        {
+            const FVertexInstanceID A = Instances[Ring * (Segments + 1) + Segment];
+            const FVertexInstanceID B = Instances[Ring * (Segments + 1) + Segment + 1];
+            const FVertexInstanceID C = Instances[(Ring + 1) * (Segments + 1) + Segment];
+            const FVertexInstanceID D = Instances[(Ring + 1) * (Segments + 1) + Segment + 1];
+
+            // The pole rows collapse to one triangle per quad
+            if (Ring > 0)
+            {
+                MeshDescription->CreateTriangle(PolygonGroup, { A, C, B });
+            }
+            if (Ring < Rings - 1)
+            {
+                MeshDescription->CreateTriangle(PolygonGroup, { B, C, D });
+            }
+        }
+    }
+
+    Mesh->CommitMeshDescription(0);
+    Mesh->Build(true);
+    FAssetRegistryModule::AssetCreated(Mesh);
+
+    return Mesh;
+}
+
+int32 UMeshToolsBenchmarkCommandlet::Main(const FString& Params)
+{
+    using namespace MeshToolsBenchmarkPrivate;
+
+    TArray<int32> TriangleCounts = { 1000, 10000, 100000, 1000000, 5000000 };
+    FString TrianglesParam;
+    if (FParse::Value(*Params, TEXT("Triangles="), TrianglesParam, false))
+    {
+        TArray<FString> Counts;
+        TrianglesParam.ParseIntoArray(Counts, TEXT(","));
+
+        TriangleCounts.Reset();
+        for (const FString& Count : Counts)
+        {
+            TriangleCounts.Add(FMath::Max(FCString::Atoi(*Count), 8));
+        }
+    }
+
+    FString BaselinePath = FPaths::ProjectDir() / TEXT("Benchmarks/MeshToolsBaseline.json");
+    FString OutputPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks/MeshTools.json");
+    FString MaterialName = TEXT("M_Red");
+    double TimeTolerance = 0.25;
+    double MemoryTolerance = 0.25;
+    double QualityTolerance = 0.1;
+    FParse::Value(*Params, TEXT("Baseline="), BaselinePath);
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+    FParse::Value(*Params, TEXT("Material="), MaterialName);
+    FParse::Value(*Params, TEXT("TimeTolerance="), TimeTolerance);
+    FParse::Value(*Params, TEXT("MemoryTolerance="), MemoryTolerance);
+    FParse::Value(*Params, TEXT("QualityTolerance="), QualityTolerance);
+    const bool bUpdateBaseline = FParse::Param(*Params, TEXT("UpdateBaseline"));
+
+    // ReplaceMaterialBatch resolves the material through the registry
+    FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+    AssetRegistryModule.Get().SearchAllAssets(true);
+
+    TriangleCounts.Sort();
+
+    TArray<FMeshToolsBenchmarkResult> Results;
+    for (int32 TargetTriangles : TriangleCounts)
+    {
+        UStaticMesh* Mesh = nullptr;
+        const FString PackageName = FString::Printf(TEXT("%s/SM_Benchmark_%d"), BENCHMARK_FOLDER, TargetTriangles);
+
+        FMeshToolsBenchmarkResult& BuildResult = Results.Add_GetRef(Measure(TEXT("BuildSourceMesh"), TargetTriangles, [&Mesh, &PackageName, TargetTriangles]()
+        {
+            Mesh = CreateSyntheticMesh(PackageName, TargetTriangles);
+        }));
+        const int32 SourceTriangles = GetNumTriangles(Mesh, 0);
+        BuildResult.QualityMetric = TEXT("Triangles");
+        BuildResult.Quality = SourceTriangles;
+
+        FMeshToolsBenchmarkResult& LODResult = Results.Add_GetRef(Measure(TEXT("GenerateLODsForMesh"), TargetTriangles, [Mesh]()
+        {
+            UMeshTools::GenerateLODsForMesh(Mesh, 1, FVector2D(0.5f, 0.5f));
+        }));
+        LODResult.QualityMetric = TEXT("LOD1TriangleRatio");
+        LODResult.Quality = SourceTriangles > 0 ? double(GetNumTriangles(Mesh, 1)) / SourceTriangles : 0.0;
+
+        FMeshToolsBenchmarkResult& CollisionResult = Results.Add_GetRef(Measure(TEXT("GenerateSimpleCollision"), TargetTriangles, [Mesh]()
+        {
+            UMeshTools::GenerateSimpleCollision(Mesh);
+        }));
+        const UBodySetup* BodySetup = Mesh->GetBodySetup();
+        CollisionResult.QualityMetric = TEXT("HullVertices");
+        CollisionResult.Quality = BodySetup && BodySetup->AggGeom.ConvexElems.Num() > 0 ? BodySetup->AggGeom.ConvexElems[0].VertexData.Num() : 0;
+
+        FMeshToolsBenchmarkResult& ClearResult = Results.Add_GetRef(Measure(TEXT("ClearLODs"), TargetTriangles, [Mesh]()
+        {
+            UMeshTools::ClearLODs(Mesh);
+        }));
+        ClearResult.QualityMetric = TEXT("RemainingLODs");
+        ClearResult.Quality = Mesh->GetNumSourceModels();
+
+        FMeshToolsBenchmarkResult& ReplaceResult = Results.Add_GetRef(Measure(TEXT("ReplaceMaterialBatch"), TargetTriangles, [Mesh, &MaterialName]()
+        {
+            UMeshTools::ReplaceMaterialBatch({ Mesh }, FString(), MaterialName);
+        }));
+        ReplaceResult.QualityMetric = TEXT("MaterialApplied");
+        ReplaceResult.Quality = Mesh->GetStaticMaterials().Num() > 0 && Mesh->GetStaticMaterials()[0].MaterialInterface && Mesh->GetStaticMaterials()[0].MaterialInterface->GetName() == MaterialName ? 1.0 : 0.0;
+
+        for (int32 Index = Results.Num() - 5; Index < Results.Num(); ++Index)
+        {
+            UE_LOG(LogTemp, Display, TEXT("MeshToolsBenchmark: %-24s %8d triangles %9.3f s %9.1f MB  %s %.3f"),
+                *Results[Index].Operation, Results[Index].Triangles, Results[Index].Seconds, Results[Index].PeakMemoryMB,
+                *Results[Index].QualityMetric, Results[Index].Quality);
+        }
+
+        // Release the mesh before the next size
+        UEditorAssetLibrary::DeleteLoadedAsset(Mesh);
+        CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    }
+
+    UEditorAssetLibrary::DeleteDirectory(BENCHMARK_FOLDER);
+
+    if (!SaveResults(OutputPath, Results))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MeshToolsBenchmark: Failed to write %s"), *OutputPath);
+    }
+
+    if (bUpdateBaseline)
+    {
+        if (!SaveResults(BaselinePath, Results))
+        {
+            UE_LOG(LogTemp, Error, TEXT("MeshToolsBenchmark: Failed to write baseline %s"), *BaselinePath);
+            return 1;
+        }
+
+        UE_LOG(LogTemp, Display, TEXT("MeshToolsBenchmark: Baseline updated: %s"), *BaselinePath);
+        return 0;
+    }
+
+    TArray<FMeshToolsBenchmarkResult> Baseline;
+    if (!LoadResults(BaselinePath, Baseline))
+    {
+        // Nothing to compare against is a failure, not a pass
+        UE_LOG(LogTemp, Error, TEXT("MeshToolsBenchmark: No baseline at %s, run with -UpdateBaseline to record one."), *BaselinePath);
+        return 1;
+    }
+
+    const int32 NumRegressions = CompareToBaseline(Results, Baseline, TimeTolerance, MemoryTolerance, QualityTolerance);
+    UE_LOG(LogTemp, Display, TEXT("MeshToolsBenchmark: %d measurements, %d regressions."), Results.Num(), NumRegressions);
+
+    return NumRegressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,149 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MeshToolsCache.h"
+#include "Engine/StaticMesh.h"
+#include "StaticMeshResources.h"
+#include "Engine/StaticMeshSourceData.h"
+#include "Hash/xxhash.h"
+#include "HAL/FileManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Paths.h"
+
+namespace MeshToolsCachePrivate
+{
+    /** Bump when the key or output hashes change meaning, older files are discarded */
+    constexpr uint32 FileVersion = 1;
+}
+
+FMeshToolsCache& FMeshToolsCache::Get()
+{
+    static FMeshToolsCache Cache;
+    return Cache;
+}
+
+FMeshToolsCache::FMeshToolsCache()
+    : FilePath(FPaths::ProjectSavedDir() / TEXT("Tools/MeshToolsCache.bin"))
+{
+    Load();
+
+    FCoreDelegates::OnEnginePreExit.AddLambda([]()
+    {
+        Get().Save();
+    });
+}
+
+uint64 FMeshToolsCache::MakeKey(const UStaticMesh* Mesh, const TCHAR* Operation, const FString& Parameters)
+{
+    const FString GeometryId = GetGeometryId(Mesh);
+    if (GeometryId.IsEmpty())
+    {
+        return NoKey;
+    }
+
+    const FString KeyString = FString::Printf(TEXT("%s|%s|%s"), *GeometryId, Operation, *Parameters);
+    const uint64 Key = FXxHash64::HashBuffer(*KeyString, KeyString.Len() * sizeof(TCHAR)).Hash;
+    return Key != NoKey ? Key : 1;
+}
+
+bool FMeshToolsCache::IsUpToDate(uint64 Key, uint64 OutputHash)
+{
+    if (Key == NoKey)
+    {
+        ++NumMisses;
+        return false;
+    }
+
+    const uint64* Recorded = Entries.Find(Key);
+    const bool bUpToDate = Recorded && *Recorded == OutputHash;
+    ++(bUpToDate ? NumHits : NumMisses);
+    return bUpToDate;
+}
+
+void FMeshToolsCache::Record(uint64 Key, uint64 OutputHash)
+{
+    if (Key == NoKey)
+    {
+        return;
+    }
+
+    uint64& Recorded = Entries.FindOrAdd(Key);
+    bDirty |= Recorded != OutputHash;
+    Recorded = OutputHash;
+}
+
+bool FMeshToolsCache::Save()
+{
+    if (!bDirty)
+    {
+        return true;
+    }
+
+    TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+    if (!Writer)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("FMeshToolsCache: Failed to write %s"), *FilePath);
+        return false;
+    }
+
+    uint32 Version = MeshToolsCachePrivate::FileVersion;
+    *Writer << Version;
+    *Writer << Entries;
+    bDirty = !Writer->Close();
+    return !bDirty;
+}
+
+void FMeshToolsCache::Load()
+{
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+    if (!Reader)
+    {
+        return;
+    }
+
+    uint32 Version = 0;
+    *Reader << Version;
+    if (Version == MeshToolsCachePrivate::FileVersion)
+    {
+        *Reader << Entries;
+    }
+
+    if (Reader->IsError())
+    {
+        Entries.Reset();
+    }
+}
+
+FString FMeshToolsCache::GetGeometryId(const UStaticMesh* Mesh)
+{
+    // The bulk data id is a hash of the stored mesh description, no need to unpack it
+    if (Mesh->GetNumSourceModels() > 0)
+    {
+        if (UStaticMeshDescriptionBulkData* BulkData = Mesh->GetSourceModel(0).GetMeshDescriptionBulkData())
+        {
+            if (!BulkData->GetBulkData().IsEmpty())
+            {
+                return BulkData->GetBulkData().GetIdString();
+            }
+        }
+    }
+
+    // Meshes without source data, hash the LOD0 render positions and indices instead
+    const FStaticMeshRenderData* RenderData = Mesh->GetRenderData();
+    if (!RenderData || RenderData->LODResources.Num() == 0)
+    {
+        return FString();
+    }
+
+    const FStaticMeshLODResources& LOD = RenderData->LODResources[0];
+    const FPositionVertexBuffer& Positions = LOD.VertexBuffers.PositionVertexBuffer;
+
+    FXxHash64Builder Builder;
+    Builder.Update(Positions.GetVertexData(), Positions.GetNumVertices() * Positions.GetStride());
+
+    TArray<uint32> Indices;
+    LOD.IndexBuffer.GetCopy(Indices);
+    Builder.Update(Indices.GetData(), Indices.Num() * sizeof(uint32));
+
+    return FString::Printf(TEXT("%016llx"), Builder.Finalize().Hash);
+}
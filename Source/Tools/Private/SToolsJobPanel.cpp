@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "SToolsJobPanel.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Notifications/SProgressBar.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "Widgets/Views/STableRow.h"
+
+#define LOCTEXT_NAMESPACE "SToolsJobPanel"
+
+namespace ToolsJobPanelPrivate
+{
+    const FName ColumnName("Name");
+    const FName ColumnState("State");
+    const FName ColumnPhase("Phase");
+    const FName ColumnProgress("Progress");
+    const FName ColumnTime("Time");
+    const FName ColumnCancel("Cancel");
+
+    class SJobRow : public SMultiColumnTableRow<TSharedPtr<FToolsJobRecord>>
+    {
+    public:
+        SLATE_BEGIN_ARGS(SJobRow) {}
+        SLATE_END_ARGS()
+
+        void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable, TSharedPtr<FToolsJobRecord> InRecord)
+        {
+            Record = InRecord;
+            SMultiColumnTableRow<TSharedPtr<FToolsJobRecord>>::Construct(FSuperRowType::FArguments(), OwnerTable);
+        }
+
+        virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnId) override
+        {
+            if (ColumnId == ColumnName)
+            {
+                return SNew(STextBlock).Text(FText::FromString(Record->Name)).ToolTipText(FText::FromString(Record->Error));
+            }
+            if (ColumnId == ColumnState)
+            {
+                return SNew(STextBlock).Text(StaticEnum<EToolsJobState>()->GetDisplayNameTextByValue((int64)Record->State));
+            }
+            if (ColumnId == ColumnPhase)
+            {
+                return SNew(STextBlock).Text(FText::FromString(Record->Phase));
+            }
+            if (ColumnId == ColumnProgress)
+            {
+                return SNew(SBox).Padding(2.0f)
+                    [
+                        SNew(SProgressBar).Percent(Record->Progress)
+                    ];
+            }
+            if (ColumnId == ColumnTime)
+            {
+                return SNew(STextBlock).Text(FText::AsNumber(Record->Seconds, &FNumberFormattingOptions::DefaultNoGrouping().SetMaximumFractionalDigits(1)));
+            }
+            if (ColumnId == ColumnCancel)
+            {
+                const bool bActive = Record->State == EToolsJobState::Pending || Record->State == EToolsJobState::Running;
+                const int32 JobId = Record->JobId;
+                return SNew(SButton)
+                    .IsEnabled(bActive)
+                    .Text(LOCTEXT("Cancel", "Cancel"))
+                    .OnClicked_Lambda([JobId]()
+                    {
+                        if (UToolsJobSubsystem* Jobs = UToolsJobSubsystem::Get())
+                        {
+                            Jobs->CancelJob(JobId);
+                        }
+                        return FReply::Handled();
+                    });
+            }
+
+            return SNullWidget::NullWidget;
+        }
+
+    private:
+        TSharedPtr<FToolsJobRecord> Record;
+    };
+}
+
+void SToolsJobPanel::Construct(const FArguments& InArgs)
+{
+    using namespace ToolsJobPanelPrivate;
+
+    ChildSlot
+    [
+        SAssignNew(ListView, SListView<TSharedPtr<FToolsJobRecord>>)
+        .ListItemsSource(&Records)
+        .OnGenerateRow(this, &SToolsJobPanel::GenerateRow)
+        .SelectionMode(ESelectionMode::None)
+        .HeaderRow
+        (
+            SNew(SHeaderRow)
+            + SHeaderRow::Column(ColumnName).DefaultLabel(LOCTEXT("Name", "Job")).FillWidth(0.3f)
+            + SHeaderRow::Column(ColumnState).DefaultLabel(LOCTEXT("State", "State")).FillWidth(0.1f)
+            + SHeaderRow::Column(ColumnPhase).DefaultLabel(LOCTEXT("Phase", "Phase")).FillWidth(0.2f)
+            + SHeaderRow::Column(ColumnProgress).DefaultLabel(LOCTEXT("Progress", "Progress")).FillWidth(0.2f)
+            + SHeaderRow::Column(ColumnTime).DefaultLabel(LOCTEXT("Time", "Seconds")).FillWidth(0.1f)
+            + SHeaderRow::Column(ColumnCancel).DefaultLabel(FText::GetEmpty()).FillWidth(0.1f)
+        )
+    ];
+
+    RegisterActiveTimer(0.25f, FWidgetActiveTimerDelegate::CreateSP(this, &SToolsJobPanel::Refresh));
+}
+
+EActiveTimerReturnType SToolsJobPanel::Refresh(double InCurrentTime, float InDeltaTime)
+{
+    Records.Reset();
+    if (UToolsJobSubsystem* Jobs = UToolsJobSubsystem::Get())
+    {
+        for (const FToolsJobRecord& Record : Jobs->GetJobs())
+        {
+            Records.Add(MakeShared<FToolsJobRecord>(Record));
+        }
+    }
+
+    ListView->RequestListRefresh();
+    return EActiveTimerReturnType::Continue;
+}
+
+TSharedRef<ITableRow> SToolsJobPanel::GenerateRow(TSharedPtr<FToolsJobRecord> Record, const TSharedRef<STableViewBase>& OwnerTable)
+{
+    return SNew(ToolsJobPanelPrivate::SJobRow, OwnerTable, Record);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,27 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+#include "ToolsJobSubsystem.h"
+
+/** Lists the active and finished jobs of UToolsJobSubsystem with their progress and a cancel button */
+class SToolsJobPanel : public SCompoundWidget
+{
+public:
+    SLATE_BEGIN_ARGS(SToolsJobPanel) {}
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs);
+
+private:
+    /** Polls the subsystem while the panel is open */
+    EActiveTimerReturnType Refresh(double InCurrentTime, float InDeltaTime);
+
+    TSharedRef<ITableRow> GenerateRow(TSharedPtr<FToolsJobRecord> Record, const TSharedRef<STableViewBase>& OwnerTable);
+
+    TArray<TSharedPtr<FToolsJobRecord>> Records;
+    TSharedPtr<SListView<TSharedPtr<FToolsJobRecord>>> ListView;
+};
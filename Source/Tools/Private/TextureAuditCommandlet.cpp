@@ -0,0 +1,34 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "TextureAuditCommandlet.h"
+#include "TextureTools.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/Paths.h"
+
+UTextureAuditCommandlet::UTextureAuditCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UTextureAuditCommandlet::Main(const FString& Params)
+{
+    FString OutputPath = FPaths::ProjectSavedDir() / TEXT("Audit/TextureAudit.csv");
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+    int32 MaxWorldSize = 2048;
+    int32 MaxUISize = 1024;
+    FParse::Value(*Params, TEXT("MaxWorldSize="), MaxWorldSize);
+    FParse::Value(*Params, TEXT("MaxUISize="), MaxUISize);
+
+    // The registry is filled asynchronously at startup, the scan needs all of it
+    FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+    AssetRegistryModule.Get().SearchAllAssets(true);
+
+    const TArray<FTextureAuditEntry> Entries = UTextureTools::AuditTextureMemory(MaxWorldSize, MaxUISize);
+
+    return UTextureTools::ExportTextureAudit(Entries, OutputPath) ? 0 : 1;
+}
@@ -0,0 +1,1076 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "TextureTools.h"
+#include "ToolEditorSubsytem.h"
+#include "ToolTextureImportRules.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "ToolsAssetRegistryCache.h"
+#include "EditorAssetLibrary.h"
+#include "Materials/MaterialInstanceConstant.h"
+#include "Async/ParallelFor.h"
+#include "Math/VectorRegister.h"
+#include "TextureCompiler.h"
+#include "UObject/Package.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "JsonObjectConverter.h"
+#include "ObjectTools.h"
+#include "ToolsStats.h"
+
+namespace TextureToolsPrivate
+{
+    enum class EORMChannel : uint8
+    {
+        Occlusion,
+        Roughness,
+        Metallic,
+        Count
+    };
+
+    /**
+     * Suffixes identifying each channel, checked case-insensitively. No single-letter forms:
+     * "_M" is the project's mask suffix and "_R" is ambiguous.
+     */
+    const TCHAR* const OcclusionSuffixes[] = { TEXT("_AO"), TEXT("_Occlusion"), TEXT("_AmbientOcclusion") };
+    const TCHAR* const RoughnessSuffixes[] = { TEXT("_Rough"), TEXT("_Roughness") };
+    const TCHAR* const MetallicSuffixes[] = { TEXT("_Metal"), TEXT("_Metallic"), TEXT("_Metalness") };
+
+    /** Value used for a channel without source texture */
+    const uint32 NeutralValues[] = { 255, 255, 0 };
+
+    /** Pixels processed per ParallelFor task */
+    const int64 PixelsPerTask = 64 * 1024;
+
+    /** Splits "T_Wood_Roughness" into "T_Wood" and EORMChannel::Roughness, returns false if no suffix matches */
+    bool SplitChannelSuffix(const FString& TextureName, FString& OutStem, EORMChannel& OutChannel)
+    {
+        auto TryMatch = [&TextureName, &OutStem, &OutChannel](TArrayView<const TCHAR* const> Suffixes, EORMChannel Channel)
+        {
+            for (const TCHAR* Suffix : Suffixes)
+            {
+                if (TextureName.EndsWith(Suffix, ESearchCase::IgnoreCase))
+                {
+                    OutStem = TextureName.LeftChop(FCString::Strlen(Suffix));
+                    OutChannel = Channel;
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        return TryMatch(OcclusionSuffixes, EORMChannel::Occlusion)
+            || TryMatch(RoughnessSuffixes, EORMChannel::Roughness)
+            || TryMatch(MetallicSuffixes, EORMChannel::Metallic);
+    }
+
+    /** Widens the first channel of the source mip into one uint32 per pixel. Returns false for unsupported formats. */
+    bool ExtractChannel(UTexture2D* Texture, TArray<uint32>& OutPlane)
+    {
+        TArray64<uint8> MipData;
+        if (!Texture->Source.GetMipData(MipData, 0, 0, 0))
+        {
+            return false;
+        }
+
+        const int64 NumPixels = int64(Texture->Source.GetSizeX()) * Texture->Source.GetSizeY();
+        OutPlane.SetNumUninitialized(NumPixels);
+        uint32* Dst = OutPlane.GetData();
+
+        switch (Texture->Source.GetFormat())
+        {
+        case TSF_G8:
+        {
+            const uint8* Src = MipData.GetData();
+            for (int64 Index = 0; Index < NumPixels; ++Index)
+            {
+                Dst[Index] = Src[Index];
+            }
+            return true;
+        }
+        case TSF_G16:
+        {
+            const uint16* Src = reinterpret_cast<const uint16*>(MipData.GetData());
+            for (int64 Index = 0; Index < NumPixels; ++Index)
+            {
+                Dst[Index] = Src[Index] >> 8;
+            }
+            return true;
+        }
+        case TSF_BGRA8:
+        {
+            // Grayscale stored as color, keep the red byte (bits 16-23), four pixels per register
+            const uint32* Src = reinterpret_cast<const uint32*>(MipData.GetData());
+            ParallelFor(int32((NumPixels + PixelsPerTask - 1) / PixelsPerTask), [Src, Dst, NumPixels](int32 Task)
+            {
+                const VectorRegister4Int ByteMask = VectorIntSet1(0xFF);
+                int64 Index = Task * PixelsPerTask;
+                const int64 End = FMath::Min(Index + PixelsPerTask, NumPixels);
+
+                for (; Index + 4 <= End; Index += 4)
+                {
+                    const VectorRegister4Int Pixels = VectorIntLoad(Src + Index);
+                    VectorIntStore(VectorIntAnd(VectorShiftRightImmLogical(Pixels, 16), ByteMask), Dst + Index);
+                }
+                for (; Index < End; ++Index)
+                {
+                    Dst[Index] = (Src[Index] >> 16) & 0xFF;
+                }
+            });
+            return true;
+        }
+        case TSF_RGBA16:
+        {
+            const uint16* Src = reinterpret_cast<const uint16*>(MipData.GetData());
+            for (int64 Index = 0; Index < NumPixels; ++Index)
+            {
+                Dst[Index] = Src[Index * 4] >> 8;
+            }
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+
+    /** True when the source mip holds gamma encoded values, only 8-bit formats are stored as sRGB */
+    bool IsSRGBSource(const UTexture2D* Texture)
+    {
+        const ETextureSourceFormat Format = Texture->Source.GetFormat();
+        return Texture->SRGB && (Format == TSF_G8 || Format == TSF_BGRA8);
+    }
+
+    /** Converts an 8-bit sRGB plane to linear values in place, the packed texture is linear */
+    void ConvertPlaneToLinear(TArray<uint32>& Plane)
+    {
+        uint32 ToLinear[256];
+        for (int32 Value = 0; Value < 256; ++Value)
+        {
+            const FLinearColor Linear = FLinearColor::FromSRGBColor(FColor(uint8(Value), uint8(Value), uint8(Value)));
+            ToLinear[Value] = uint32(FMath::Clamp(FMath::RoundToInt(Linear.R * 255.0f), 0, 255));
+        }
+
+        uint32* Data = Plane.GetData();
+        const int64 NumPixels = Plane.Num();
+        ParallelFor(int32((NumPixels + PixelsPerTask - 1) / PixelsPerTask), [&ToLinear, Data, NumPixels](int32 Task)
+        {
+            const int64 End = FMath::Min((Task + 1) * PixelsPerTask, NumPixels);
+            for (int64 Index = Task * PixelsPerTask; Index < End; ++Index)
+            {
+                Data[Index] = ToLinear[Data[Index]];
+            }
+        });
+    }
+
+    /** Interleaves the three planes into BGRA8 pixels: R = Occlusion, G = Roughness, B = Metallic, opaque alpha */
+    void PackPlanes(const uint32* Occlusion, const uint32* Roughness, const uint32* Metallic, uint32* Dst, int64 NumPixels)
+    {
+        ParallelFor(int32((NumPixels + PixelsPerTask - 1) / PixelsPerTask), [=](int32 Task)
+        {
+            const VectorRegister4Int Alpha = VectorIntSet1(int32(0xFF000000));
+            int64 Index = Task * PixelsPerTask;
+            const int64 End = FMath::Min(Index + PixelsPerTask, NumPixels);
+
+            for (; Index + 4 <= End; Index += 4)
+            {
+                const VectorRegister4Int B = VectorIntLoad(Metallic + Index);
+                const VectorRegister4Int G = VectorShiftLeftImm(VectorIntLoad(Roughness + Index), 8);
+                const VectorRegister4Int R = VectorShiftLeftImm(VectorIntLoad(Occlusion + Index), 16);
+                VectorIntStore(VectorIntOr(VectorIntOr(B, G), VectorIntOr(R, Alpha)), Dst + Index);
+            }
+            for (; Index < End; ++Index)
+            {
+                Dst[Index] = Metallic[Index] | (Roughness[Index] << 8) | (Occlusion[Index] << 16) | 0xFF000000u;
+            }
+        });
+    }
+
+    int64 GetTextureMemory(UTexture2D* Texture)
+    {
+        return int64(Texture->CalcTextureMemorySizeEnum(TMC_AllMips));
+    }
+
+    /** Textures loaded between two garbage collections when running as a commandlet */
+    const int32 AuditBatchSize = 256;
+
+    /** True if the referencing asset draws its textures as UI */
+    bool IsUIReferencer(const FAssetData& Asset)
+    {
+        const FName ClassName = Asset.AssetClassPath.GetAssetName();
+        if (ClassName == TEXT("WidgetBlueprint") || ClassName == TEXT("SlateBrushAsset") || ClassName == TEXT("SlateWidgetStyleAsset") || ClassName == TEXT("Font"))
+        {
+            return true;
+        }
+
+        FString MaterialDomain;
+        return Asset.GetTagValue(FName("MaterialDomain"), MaterialDomain) && MaterialDomain == TEXT("MD_UI");
+    }
+
+    bool IsMaterialReferencer(const FAssetData& Asset)
+    {
+        const FName ClassName = Asset.AssetClassPath.GetAssetName();
+        return ClassName == TEXT("Material") || ClassName == TEXT("MaterialInstanceConstant");
+    }
+
+    /** Source mip bytes held in memory at once while hashing, a larger texture gets a batch of its own */
+    const int64 HashBatchMaxBytes = 512ll * 1024 * 1024;
+
+    /** Textures hashed per batch when they are small */
+    const int32 HashBatchMaxTextures = 64;
+
+    /** Resolution of the grid the pHash DCT runs on */
+    const int32 PHashGridSize = 32;
+
+    /** Source mip copied on the game thread, hashed on a worker */
+    struct FTextureHashInput
+    {
+        TArray64<uint8> MipData;
+        ETextureSourceFormat Format = TSF_Invalid;
+        int32 Width = 0;
+        int32 Height = 0;
+    };
+
+    struct FTexturePerceptualHash
+    {
+        uint64 DHash = 0;
+        uint64 PHash = 0;
+        bool bValid = false;
+    };
+
+    /**
+    * Box-filters the source mip into luminance grids of GridWidth x GridHeight cells.
+    * Each pixel is loaded as a float4 and accumulated into its cell, weights are applied once per cell.
+    */
+    bool DownsampleLuminance(const FTextureHashInput& Input, int32 GridWidth, int32 GridHeight, TArray<float>& OutGrid)
+    {
+        VectorRegister4Float Weights;
+        int32 BytesPerPixel = 0;
+
+        switch (Input.Format)
+        {
+        case TSF_BGRA8:
+            Weights = MakeVectorRegisterFloat(0.114f, 0.587f, 0.299f, 0.0f);
+            BytesPerPixel = 4;
+            break;
+        case TSF_RGBA16:
+            Weights = MakeVectorRegisterFloat(0.299f, 0.587f, 0.114f, 0.0f);
+            BytesPerPixel = 8;
+            break;
+        case TSF_G8:
+            Weights = MakeVectorRegisterFloat(1.0f, 0.0f, 0.0f, 0.0f);
+            BytesPerPixel = 1;
+            break;
+        default:
+            return false;
+        }
+
+        TArray<VectorRegister4Float> CellSums;
+        CellSums.Init(VectorZeroFloat(), GridWidth * GridHeight);
+        TArray<int32> CellCounts;
+        CellCounts.SetNumZeroed(GridWidth * GridHeight);
+
+        TArray<int32> ColumnCells;
+        ColumnCells.SetNumUninitialized(Input.Width);
+        for (int32 X = 0; X < Input.Width; ++X)
+        {
+            ColumnCells[X] = int32(int64(X) * GridWidth / Input.Width);
+        }
+
+        for (int32 Y = 0; Y < Input.Height; ++Y)
+        {
+            const int32 RowCell = int32(int64(Y) * GridHeight / Input.Height) * GridWidth;
+            const uint8* Row = Input.MipData.GetData() + int64(Y) * Input.Width * BytesPerPixel;
+
+            for (int32 X = 0; X < Input.Width; ++X)
+            {
+                const uint8* Pixel = Row + int64(X) * BytesPerPixel;
+                VectorRegister4Float Value;
+                if (BytesPerPixel == 4)
+                {
+                    Value = VectorLoadByte4(Pixel);
+                }
+                else if (BytesPerPixel == 8)
+                {
+                    Value = VectorLoadURGBA16N(reinterpret_cast<const uint16*>(Pixel));
+                }
+                else
+                {
+                    Value = VectorSetFloat1(float(*Pixel));
+                }
+
+                const int32 Cell = RowCell + ColumnCells[X];
+                CellSums[Cell] = VectorAdd(CellSums[Cell], Value);
+                ++CellCounts[Cell];
+            }
+        }
+
+        OutGrid.SetNumUninitialized(GridWidth * GridHeight);
+        for (int32 Cell = 0; Cell < CellSums.Num(); ++Cell)
+        {
+            const float Luminance = VectorGetComponent(VectorDot4(CellSums[Cell], Weights), 0);
+            OutGrid[Cell] = CellCounts[Cell] > 0 ? Luminance / CellCounts[Cell] : 0.0f;
+        }
+
+        return true;
+    }
+
+    FTexturePerceptualHash ComputePerceptualHash(const FTextureHashInput& Input)
+    {
+        FTexturePerceptualHash Hash;
+
+        // dHash: one bit per horizontal gradient sign on a 9x8 grid
+        TArray<float> DGrid;
+        if (!DownsampleLuminance(Input, 9, 8, DGrid))
+        {
+            return Hash;
+        }
+
+        for (int32 Y = 0; Y < 8; ++Y)
+        {
+            for (int32 X = 0; X < 8; ++X)
+            {
+                if (DGrid[Y * 9 + X] < DGrid[Y * 9 + X + 1])
+                {
+                    Hash.DHash |= uint64(1) << (Y * 8 + X);
+                }
+            }
+        }
+
+        // pHash: lowest 8x8 frequencies of a 32x32 DCT compared to their median
+        TArray<float> PGrid;
+        DownsampleLuminance(Input, PHashGridSize, PHashGridSize, PGrid);
+
+        float CosTable[8][PHashGridSize];
+        for (int32 Frequency = 0; Frequency < 8; ++Frequency)
+        {
+            for (int32 Sample = 0; Sample < PHashGridSize; ++Sample)
+            {
+                CosTable[Frequency][Sample] = FMath::Cos((2 * Sample + 1) * Frequency * UE_PI / (2 * PHashGridSize));
+            }
+        }
+
+        // Separable DCT: rows first, then columns, only the 8 lowest frequencies are needed
+        float RowPass[PHashGridSize][8];
+        for (int32 Y = 0; Y < PHashGridSize; ++Y)
+        {
+            for (int32 U = 0; U < 8; ++U)
+            {
+                float Sum = 0.0f;
+                for (int32 X = 0; X < PHashGridSize; ++X)
+                {
+                    Sum += PGrid[Y * PHashGridSize + X] * CosTable[U][X];
+                }
+                RowPass[Y][U] = Sum;
+            }
+        }
+
+        float Coefficients[64];
+        for (int32 V = 0; V < 8; ++V)
+        {
+            for (int32 U = 0; U < 8; ++U)
+            {
+                float Sum = 0.0f;
+                for (int32 Y = 0; Y < PHashGridSize; ++Y)
+                {
+                    Sum += RowPass[Y][U] * CosTable[V][Y];
+                }
+                Coefficients[V * 8 + U] = Sum;
+            }
+        }
+
+        // The DC term only carries the average brightness
+        TArray<float> Sorted(Coefficients + 1, 63);
+        Sorted.Sort();
+        const float Median = Sorted[31];
+
+        for (int32 Index = 1; Index < 64; ++Index)
+        {
+            if (Coefficients[Index] > Median)
+            {
+                Hash.PHash |= uint64(1) << Index;
+            }
+        }
+
+        Hash.bValid = true;
+        return Hash;
+    }
+
+    /** Textures can only be duplicates when they are sampled and compressed the same way */
+    uint32 GetDuplicateSettingsKey(const UTexture2D* Texture)
+    {
+        return (uint32(Texture->SRGB) << 16) | (uint32(Texture->CompressionSettings) << 8) | uint32(Texture->LODGroup);
+    }
+}
+
+TArray<FORMPackReport> UTextureTools::PackORMTextures(const FString& Folder, FName ORMParameterName, bool bRewireMaterialInstances)
+{
+    using namespace TextureToolsPrivate;
+
+    TOOLS_OPERATION_SCOPE("PackORMTextures");
+
+    TArray<FORMPackReport> Reports;
+
+    // Query every texture in the folder, names only
+    FARFilter Filter;
+    Filter.bRecursivePaths = true;
+    Filter.PackagePaths.Add(FName(*Folder));
+    Filter.ClassPaths.Add(UTexture2D::StaticClass()->GetClassPathName());
+
+    FToolsAssetRegistryCache& RegistryCache = FToolsAssetRegistryCache::Get();
+    ToolsOperationProfile.BeginPhase(TEXT("Registry Query"));
+    FToolsAssetRegistryCache::FAssetList TextureAssetList = RegistryCache.GetAssets(Filter);
+    ToolsOperationProfile.EndPhase();
+    const TArray<FAssetData>& TextureAssets = *TextureAssetList;
+    FToolsOperationProfile::CountAssetsScanned(TextureAssets.Num());
+
+    // Group by folder and name stem, the folder being the one the import subsystem picked from the base name
+    TMap<FString, TStaticArray<FAssetData, (int32)EORMChannel::Count>> Sets;
+    for (const FAssetData& Asset : TextureAssets)
+    {
+        FString Stem;
+        EORMChannel Channel;
+        if (SplitChannelSuffix(Asset.AssetName.ToString(), Stem, Channel))
+        {
+            Sets.FindOrAdd(Asset.PackagePath.ToString() / Stem)[(int32)Channel] = Asset;
+        }
+    }
+
+    for (TPair<FString, TStaticArray<FAssetData, (int32)EORMChannel::Count>>& Set : Sets)
+    {
+        const FString SetPath = Set.Key;
+        const FAssetData& RoughnessAsset = Set.Value[(int32)EORMChannel::Roughness];
+
+        int32 NumMaps = 0;
+        for (const FAssetData& Asset : Set.Value)
+        {
+            NumMaps += Asset.IsValid() ? 1 : 0;
+        }
+
+        if (!RoughnessAsset.IsValid() || NumMaps < 2)
+        {
+            continue;
+        }
+
+        const FString PackedName = FPaths::GetCleanFilename(SetPath) + TEXT("_ORM");
+        const FString PackedPackageName = FPaths::GetPath(SetPath) / PackedName;
+        if (UEditorAssetLibrary::DoesAssetExist(PackedPackageName))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("PackORMTextures: %s already exists, skipping set."), *PackedPackageName);
+            continue;
+        }
+
+        // Load the sources and read their first channel
+        TStaticArray<UTexture2D*, (int32)EORMChannel::Count> Sources(InPlace, nullptr);
+        TStaticArray<TArray<uint32>, (int32)EORMChannel::Count> Planes;
+        int32 Width = 0;
+        int32 Height = 0;
+        bool bValid = true;
+
+        ToolsOperationProfile.BeginPhase(TEXT("Read Sources"));
+        for (int32 Channel = 0; Channel < (int32)EORMChannel::Count && bValid; ++Channel)
+        {
+            if (!Set.Value[Channel].IsValid())
+            {
+                continue;
+            }
+
+            UTexture2D* Texture = Cast<UTexture2D>(Set.Value[Channel].GetAsset());
+            if (!Texture)
+            {
+                bValid = false;
+                break;
+            }
+
+            if (Width == 0)
+            {
+                Width = Texture->Source.GetSizeX();
+                Height = Texture->Source.GetSizeY();
+            }
+
+            if (Texture->Source.GetSizeX() != Width || Texture->Source.GetSizeY() != Height)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("PackORMTextures: %s has mismatching resolutions, skipping set."), *SetPath);
+                bValid = false;
+            }
+            else if (!ExtractChannel(Texture, Planes[Channel]))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("PackORMTextures: Unsupported source format on %s, skipping set."), *Texture->GetName());
+                bValid = false;
+            }
+            else if (IsSRGBSource(Texture))
+            {
+                ConvertPlaneToLinear(Planes[Channel]);
+            }
+
+            Sources[Channel] = Texture;
+            FToolsOperationProfile::CountBytesTouched(Planes[Channel].Num() * sizeof(uint32));
+        }
+        ToolsOperationProfile.EndPhase();
+
+        if (!bValid)
+        {
+            continue;
+        }
+
+        const int64 NumPixels = int64(Width) * Height;
+        for (int32 Channel = 0; Channel < (int32)EORMChannel::Count; ++Channel)
+        {
+            if (!Sources[Channel])
+            {
+                Planes[Channel].Init(NeutralValues[Channel], NumPixels);
+            }
+        }
+
+        TArray<uint32> PackedPixels;
+        PackedPixels.SetNumUninitialized(NumPixels);
+        {
+            TOOLS_PHASE_SCOPE("Pack", STAT_Tools_TextureProcess);
+            PackPlanes(Planes[(int32)EORMChannel::Occlusion].GetData(), Planes[(int32)EORMChannel::Roughness].GetData(),
+                Planes[(int32)EORMChannel::Metallic].GetData(), PackedPixels.GetData(), NumPixels);
+        }
+
+        // Create the packed asset next to its sources
+        UPackage* Package = CreatePackage(*PackedPackageName);
+        UTexture2D* Packed = NewObject<UTexture2D>(Package, *PackedName, RF_Public | RF_Standalone | RF_Transactional);
+        Packed->Source.Init(Width, Height, 1, 1, TSF_BGRA8, reinterpret_cast<const uint8*>(PackedPixels.GetData()));
+        Packed->LODGroup = Sources[(int32)EORMChannel::Roughness]->LODGroup;
+
+        // Same settings an imported "_ORM" texture would get
+        if (const FTextureImportRule* Rule = GetDefault<UToolTextureImportRules>()->FindRule(PackedName))
+        {
+            UToolEditorSubsytem::ApplyImportRule(Packed, *Rule);
+        }
+        else
+        {
+            Packed->SRGB = false;
+            Packed->CompressionSettings = TC_Masks;
+            Packed->PostEditChange();
+        }
+
+        FAssetRegistryModule::AssetCreated(Packed);
+        Packed->MarkPackageDirty();
+        {
+            TOOLS_PHASE_SCOPE("Compile", STAT_Tools_TextureProcess);
+            FTextureCompilingManager::Get().FinishCompilation({ Packed });
+            FToolsOperationProfile::CountBuilds(1);
+        }
+
+        {
+            TOOLS_PHASE_SCOPE("Save", STAT_Tools_Save);
+            if (!UEditorAssetLibrary::SaveLoadedAsset(Packed))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("PackORMTextures: Failed to save packed texture: %s"), *PackedPackageName);
+            }
+            FToolsOperationProfile::CountSaves(1);
+        }
+
+        FORMPackReport& Report = Reports.AddDefaulted_GetRef();
+        Report.PackedTexture = Packed;
+        Report.PackedBytes = GetTextureMemory(Packed);
+
+        for (UTexture2D* Source : Sources)
+        {
+            if (Source)
+            {
+                Report.SourceTextures.Add(Source);
+                Report.SourceBytes += GetTextureMemory(Source);
+            }
+        }
+
+        if (bRewireMaterialInstances)
+        {
+            TOOLS_PHASE_SCOPE("Rewire Instances", STAT_Tools_Save);
+
+            // Material instances referencing any of the sources
+            TSet<FName> ReferencerPackages;
+            for (UTexture2D* Source : Report.SourceTextures)
+            {
+                ReferencerPackages.Append(RegistryCache.GetReferencers(Source->GetOutermost()->GetFName()));
+            }
+
+            for (const FName& ReferencerPackage : ReferencerPackages)
+            {
+                FToolsAssetRegistryCache::FAssetList ReferencerAssets = RegistryCache.GetAssetsByPackageName(ReferencerPackage);
+                for (const FAssetData& ReferencerAsset : *ReferencerAssets)
+                {
+                    if (!ReferencerAsset.IsInstanceOf(UMaterialInstanceConstant::StaticClass()))
+                    {
+                        continue;
+                    }
+
+                    UMaterialInstanceConstant* Instance = Cast<UMaterialInstanceConstant>(ReferencerAsset.GetAsset());
+                    if (!Instance)
+                    {
+                        continue;
+                    }
+
+                    // The parent must sample the packed channels through a dedicated parameter
+                    TArray<FMaterialParameterInfo> ParameterInfos;
+                    TArray<FGuid> ParameterIds;
+                    Instance->GetAllTextureParameterInfo(ParameterInfos, ParameterIds);
+                    if (!ParameterInfos.ContainsByPredicate([ORMParameterName](const FMaterialParameterInfo& Info) { return Info.Name == ORMParameterName; }))
+                    {
+                        ++Report.MaterialInstancesSkipped;
+                        UE_LOG(LogTemp, Warning, TEXT("PackORMTextures: Parent of %s has no '%s' parameter, switch it manually."), *Instance->GetName(), *ORMParameterName.ToString());
+                        continue;
+                    }
+
+                    Instance->Modify();
+                    Instance->SetTextureParameterValueEditorOnly(FMaterialParameterInfo(ORMParameterName), Packed);
+                    Instance->TextureParameterValues.RemoveAll([&Report](const FTextureParameterValue& Value)
+                    {
+                        return Report.SourceTextures.Contains(Value.ParameterValue);
+                    });
+                    Instance->PostEditChange();
+                    Instance->MarkPackageDirty();
+
+                    if (!UEditorAssetLibrary::SaveLoadedAsset(Instance))
+                    {
+                        UE_LOG(LogTemp, Warning, TEXT("PackORMTextures: Failed to save material instance: %s"), *Instance->GetPathName());
+                    }
+                    FToolsOperationProfile::CountSaves(1);
+
+                    ++Report.MaterialInstancesRewired;
+                }
+            }
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("PackORMTextures: %s from %d maps, %.2f MB -> %.2f MB, %d instances rewired, %d skipped"),
+            *PackedName, Report.SourceTextures.Num(), Report.SourceBytes / (1024.0f * 1024.0f), Report.PackedBytes / (1024.0f * 1024.0f),
+            Report.MaterialInstancesRewired, Report.MaterialInstancesSkipped);
+    }
+
+    int64 TotalSaved = 0;
+    for (const FORMPackReport& Report : Reports)
+    {
+        TotalSaved += Report.SourceBytes - Report.PackedBytes;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("PackORMTextures: Packed %d sets. Texture memory saved once sources are unreferenced: %.2f MB"), Reports.Num(), TotalSaved / (1024.0f * 1024.0f));
+    return Reports;
+}
+
+TArray<FTextureAuditEntry> UTextureTools::AuditTextureMemory(int32 MaxWorldSize, int32 MaxUISize)
+{
+    using namespace TextureToolsPrivate;
+
+    TOOLS_OPERATION_SCOPE("AuditTextureMemory");
+
+    TArray<FTextureAuditEntry> Entries;
+
+    FARFilter Filter;
+    Filter.bRecursivePaths = true;
+    Filter.PackagePaths.Add(FName("/Game"));
+    Filter.ClassPaths.Add(UTexture2D::StaticClass()->GetClassPathName());
+
+    FToolsAssetRegistryCache& RegistryCache = FToolsAssetRegistryCache::Get();
+    ToolsOperationProfile.BeginPhase(TEXT("Registry Query"));
+    FToolsAssetRegistryCache::FAssetList TextureAssetList = RegistryCache.GetAssets(Filter);
+    ToolsOperationProfile.EndPhase();
+    const TArray<FAssetData>& TextureAssets = *TextureAssetList;
+    FToolsOperationProfile::CountAssetsScanned(TextureAssets.Num());
+
+    Entries.SetNum(TextureAssets.Num());
+    TArray<bool> IsUIGroup;
+    IsUIGroup.SetNumZeroed(TextureAssets.Num());
+
+    // Snapshot the loaded textures on the game thread, in batches so commandlet runs can release memory
+    for (int32 BatchStart = 0; BatchStart < TextureAssets.Num(); BatchStart += AuditBatchSize)
+    {
+        const int32 BatchEnd = FMath::Min(BatchStart + AuditBatchSize, TextureAssets.Num());
+
+        TArray<UTexture*> BatchTextures;
+        {
+            TOOLS_PHASE_SCOPE("Load", STAT_Tools_Load);
+            for (int32 Index = BatchStart; Index < BatchEnd; ++Index)
+            {
+                if (UTexture2D* Texture = Cast<UTexture2D>(TextureAssets[Index].GetAsset()))
+                {
+                    BatchTextures.Add(Texture);
+                }
+            }
+            FTextureCompilingManager::Get().FinishCompilation(BatchTextures);
+        }
+
+        for (int32 Index = BatchStart; Index < BatchEnd; ++Index)
+        {
+            FTextureAuditEntry& Entry = Entries[Index];
+            Entry.AssetPath = TextureAssets[Index].GetObjectPathString();
+
+            UTexture2D* Texture = Cast<UTexture2D>(TextureAssets[Index].GetAsset());
+            const FTexturePlatformData* PlatformData = Texture ? Texture->GetPlatformData() : nullptr;
+            if (!PlatformData)
+            {
+                continue;
+            }
+
+            Entry.Width = Texture->GetSizeX();
+            Entry.Height = Texture->GetSizeY();
+            Entry.Format = GetPixelFormatString(PlatformData->PixelFormat);
+            Entry.NumMips = PlatformData->Mips.Num();
+            Entry.MemoryBytes = GetTextureMemory(Texture);
+            FToolsOperationProfile::CountBytesTouched(Entry.MemoryBytes);
+            Entry.LODGroup = UTexture::GetTextureGroupString(Texture->LODGroup);
+            Entry.bNeverStream = Texture->NeverStream;
+            Entry.bNonPowerOfTwo = !FMath::IsPowerOfTwo(Entry.Width) || !FMath::IsPowerOfTwo(Entry.Height);
+            Entry.bStreamable = !Entry.bNeverStream && !Entry.bNonPowerOfTwo && Entry.NumMips > 1;
+            IsUIGroup[Index] = Texture->LODGroup == TEXTUREGROUP_UI;
+        }
+
+        if (IsRunningCommandlet())
+        {
+            TOOLS_PHASE_SCOPE("Garbage Collection", STAT_Tools_Load);
+            CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+        }
+    }
+
+    // Classify usage from the registry graph and compute recommendations, no UObject access from here
+    ToolsOperationProfile.BeginPhase(TEXT("Classify Usage"));
+    ParallelFor(Entries.Num(), [&Entries, &TextureAssets, &IsUIGroup, &RegistryCache, MaxWorldSize, MaxUISize](int32 Index)
+    {
+        FTextureAuditEntry& Entry = Entries[Index];
+        if (Entry.NumMips == 0)
+        {
+            return;
+        }
+
+        const TArray<FName> Referencers = RegistryCache.GetReferencers(TextureAssets[Index].PackageName);
+
+        bool bUsedByUI = IsUIGroup[Index];
+        for (const FName& Referencer : Referencers)
+        {
+            FToolsAssetRegistryCache::FAssetList ReferencerAssets = RegistryCache.GetAssetsByPackageName(Referencer);
+            for (const FAssetData& ReferencerAsset : *ReferencerAssets)
+            {
+                bUsedByUI |= IsUIReferencer(ReferencerAsset);
+                if (IsMaterialReferencer(ReferencerAsset))
+                {
+                    Entry.Materials.Add(ReferencerAsset.AssetName.ToString());
+                }
+            }
+        }
+
+        Entry.Usage = bUsedByUI ? TEXT("UI") : (Referencers.Num() > 0 ? TEXT("World") : TEXT("Unused"));
+        if (Referencers.Num() == 0 && !bUsedByUI)
+        {
+            return;
+        }
+
+        // Memory scales with the texel count, the largest dimension is clamped to the limit
+        const int32 Limit = bUsedByUI ? MaxUISize : MaxWorldSize;
+        const int32 LargestSize = FMath::Max(Entry.Width, Entry.Height);
+        if (Limit > 0 && LargestSize > Limit)
+        {
+            const double Ratio = double(Limit) / LargestSize;
+            Entry.SuggestedMaxSize = Limit;
+            Entry.SuggestedSavingsBytes = Entry.MemoryBytes - int64(Entry.MemoryBytes * Ratio * Ratio);
+        }
+    });
+    ToolsOperationProfile.EndPhase();
+
+    Entries.RemoveAll([](const FTextureAuditEntry& Entry) { return Entry.NumMips == 0; });
+    Entries.Sort([](const FTextureAuditEntry& A, const FTextureAuditEntry& B) { return A.MemoryBytes > B.MemoryBytes; });
+
+    int64 TotalBytes = 0;
+    int64 TotalSavings = 0;
+    int32 NonStreamableCount = 0;
+    for (const FTextureAuditEntry& Entry : Entries)
+    {
+        TotalBytes += Entry.MemoryBytes;
+        TotalSavings += Entry.SuggestedSavingsBytes;
+        NonStreamableCount += (Entry.bNonPowerOfTwo && !Entry.bStreamable) ? 1 : 0;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("AuditTextureMemory: %d textures, %.2f MB total, %d non power of two textures that cannot stream, %.2f MB saved by the suggested sizes"),
+        Entries.Num(), TotalBytes / (1024.0f * 1024.0f), NonStreamableCount, TotalSavings / (1024.0f * 1024.0f));
+
+    return Entries;
+}
+
+bool UTextureTools::ExportTextureAudit(const TArray<FTextureAuditEntry>& Entries, const FString& FilePath)
+{
+    FString Output;
+
+    if (FPaths::GetExtension(FilePath).Equals(TEXT("json"), ESearchCase::IgnoreCase))
+    {
+        TArray<TSharedPtr<FJsonValue>> JsonEntries;
+        for (const FTextureAuditEntry& Entry : Entries)
+        {
+            JsonEntries.Add(MakeShared<FJsonValueObject>(FJsonObjectConverter::UStructToJsonObject(Entry)));
+        }
+
+        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+        if (!FJsonSerializer::Serialize(JsonEntries, Writer))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        Output += TEXT("AssetPath,Width,Height,Format,NumMips,MemoryBytes,LODGroup,NeverStream,Streamable,NonPowerOfTwo,Usage,Materials,SuggestedMaxSize,SuggestedSavingsBytes\n");
+        for (const FTextureAuditEntry& Entry : Entries)
+        {
+            Output += FString::Printf(TEXT("%s,%d,%d,%s,%d,%lld,%s,%d,%d,%d,%s,\"%s\",%d,%lld\n"),
+                *Entry.AssetPath, Entry.Width, Entry.Height, *Entry.Format, Entry.NumMips, Entry.MemoryBytes, *Entry.LODGroup,
+                Entry.bNeverStream, Entry.bStreamable, Entry.bNonPowerOfTwo, *Entry.Usage, *FString::Join(Entry.Materials, TEXT(";")),
+                Entry.SuggestedMaxSize, Entry.SuggestedSavingsBytes);
+        }
+    }
+
+    if (!FFileHelper::SaveStringToFile(Output, *FilePath))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ExportTextureAudit: Failed to write %s"), *FilePath);
+        return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("ExportTextureAudit: Wrote %d entries to %s"), Entries.Num(), *FilePath);
+    return true;
+}
+
+TArray<FTextureDuplicateGroup> UTextureTools::FindDuplicateTextures(const FString& Folder, int32 MaxHammingDistance)
+{
+    using namespace TextureToolsPrivate;
+
+    TOOLS_OPERATION_SCOPE("FindDuplicateTextures");
+
+    TArray<FTextureDuplicateGroup> Groups;
+
+    FARFilter Filter;
+    Filter.bRecursivePaths = true;
+    Filter.PackagePaths.Add(FName(*Folder));
+    Filter.ClassPaths.Add(UTexture2D::StaticClass()->GetClassPathName());
+
+    FToolsAssetRegistryCache& RegistryCache = FToolsAssetRegistryCache::Get();
+    ToolsOperationProfile.BeginPhase(TEXT("Registry Query"));
+    FToolsAssetRegistryCache::FAssetList TextureAssetList = RegistryCache.GetAssets(Filter);
+    ToolsOperationProfile.EndPhase();
+    const TArray<FAssetData>& TextureAssets = *TextureAssetList;
+    FToolsOperationProfile::CountAssetsScanned(TextureAssets.Num());
+
+    const int32 NumTextures = TextureAssets.Num();
+    TArray<FTexturePerceptualHash> Hashes;
+    Hashes.SetNum(NumTextures);
+    TArray<FIntPoint> Sizes;
+    Sizes.SetNumZeroed(NumTextures);
+    TArray<uint32> SettingsKeys;
+    SettingsKeys.SetNumZeroed(NumTextures);
+
+    // Read source mips on the game thread, hash each batch across all cores
+    int32 BatchStart = 0;
+    while (BatchStart < NumTextures)
+    {
+        TArray<FTextureHashInput> Inputs;
+        Inputs.Reserve(HashBatchMaxTextures);
+        int64 BatchBytes = 0;
+
+        // The batch closes on its byte budget, 8K sources are hashed a few at a time
+        ToolsOperationProfile.BeginPhase(TEXT("Read Sources"));
+        int32 Index = BatchStart;
+        for (; Index < NumTextures && Inputs.Num() < HashBatchMaxTextures; ++Index)
+        {
+            UTexture2D* Texture = Cast<UTexture2D>(TextureAssets[Index].GetAsset());
+            const bool bHasSource = Texture && Texture->Source.IsValid();
+
+            const int64 MipBytes = bHasSource ? Texture->Source.CalcMipSize(0) : 0;
+            if (Inputs.Num() > 0 && BatchBytes + MipBytes > HashBatchMaxBytes)
+            {
+                break;
+            }
+
+            FTextureHashInput& Input = Inputs.AddDefaulted_GetRef();
+            if (bHasSource && Texture->Source.GetMipData(Input.MipData, 0, 0, 0))
+            {
+                Input.Format = Texture->Source.GetFormat();
+                Input.Width = Texture->Source.GetSizeX();
+                Input.Height = Texture->Source.GetSizeY();
+                Sizes[Index] = FIntPoint(Input.Width, Input.Height);
+                SettingsKeys[Index] = GetDuplicateSettingsKey(Texture);
+                BatchBytes += Input.MipData.Num();
+                FToolsOperationProfile::CountBytesTouched(Input.MipData.Num());
+            }
+        }
+        ToolsOperationProfile.EndPhase();
+
+        {
+            TOOLS_PHASE_SCOPE("Hash", STAT_Tools_TextureProcess);
+            ParallelFor(Inputs.Num(), [&Inputs, &Hashes, BatchStart](int32 Index)
+            {
+                if (Inputs[Index].Width > 0)
+                {
+                    Hashes[BatchStart + Index] = ComputePerceptualHash(Inputs[Index]);
+                }
+            });
+        }
+
+        BatchStart = Index;
+
+        if (IsRunningCommandlet())
+        {
+            TOOLS_PHASE_SCOPE("Garbage Collection", STAT_Tools_Load);
+            CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+        }
+    }
+
+    // Pairwise comparison, one row of the triangle per task
+    TArray<TArray<int32>> Matches;
+    Matches.SetNum(NumTextures);
+    ToolsOperationProfile.BeginPhase(TEXT("Compare"));
+    ParallelFor(NumTextures, [&Hashes, &Sizes, &SettingsKeys, &Matches, NumTextures, MaxHammingDistance](int32 Index)
+    {
+        const FTexturePerceptualHash& Hash = Hashes[Index];
+        if (!Hash.bValid)
+        {
+            return;
+        }
+
+        const double AspectRatio = double(Sizes[Index].X) / Sizes[Index].Y;
+        for (int32 Other = Index + 1; Other < NumTextures; ++Other)
+        {
+            const FTexturePerceptualHash& OtherHash = Hashes[Other];
+            // Hashes only see luminance, a normal map and a colour texture can hash alike
+            if (!OtherHash.bValid || SettingsKeys[Other] != SettingsKeys[Index]
+                || !FMath::IsNearlyEqual(AspectRatio, double(Sizes[Other].X) / Sizes[Other].Y, 0.01))
+            {
+                continue;
+            }
+
+            if (FMath::CountBits(Hash.PHash ^ OtherHash.PHash) <= uint64(MaxHammingDistance)
+                && FMath::CountBits(Hash.DHash ^ OtherHash.DHash) <= uint64(MaxHammingDistance))
+            {
+                Matches[Index].Add(Other);
+            }
+        }
+    });
+    ToolsOperationProfile.EndPhase();
+
+    // Matches do not chain: every member of a group is within the threshold of its keeper
+    TArray<TArray<int32>> Neighbours;
+    Neighbours.SetNum(NumTextures);
+    for (int32 Index = 0; Index < NumTextures; ++Index)
+    {
+        for (int32 Other : Matches[Index])
+        {
+            Neighbours[Index].Add(Other);
+            Neighbours[Other].Add(Index);
+        }
+    }
+
+    // Highest resolution textures become keepers first
+    TArray<int32> Order;
+    for (int32 Index = 0; Index < NumTextures; ++Index)
+    {
+        if (Neighbours[Index].Num() > 0)
+        {
+            Order.Add(Index);
+        }
+    }
+    Order.StableSort([&Sizes](int32 A, int32 B) { return int64(Sizes[A].X) * Sizes[A].Y > int64(Sizes[B].X) * Sizes[B].Y; });
+
+    TBitArray<> Assigned(false, NumTextures);
+    for (int32 Keeper : Order)
+    {
+        if (Assigned[Keeper])
+        {
+            continue;
+        }
+
+        TArray<int32> Indices;
+        for (int32 Other : Neighbours[Keeper])
+        {
+            if (!Assigned[Other])
+            {
+                Indices.Add(Other);
+            }
+        }
+
+        if (Indices.Num() == 0)
+        {
+            continue;
+        }
+
+        Assigned[Keeper] = true;
+        FTextureDuplicateGroup& Group = Groups.AddDefaulted_GetRef();
+        Group.AssetPaths.Add(TextureAssets[Keeper].GetObjectPathString());
+        for (int32 Index : Indices)
+        {
+            Assigned[Index] = true;
+            Group.AssetPaths.Add(TextureAssets[Index].GetObjectPathString());
+            Group.MaxDistance = FMath::Max(Group.MaxDistance, int32(FMath::Max(
+                FMath::CountBits(Hashes[Keeper].PHash ^ Hashes[Index].PHash), FMath::CountBits(Hashes[Keeper].DHash ^ Hashes[Index].DHash))));
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("FindDuplicateTextures: %s has %d near-duplicates (distance <= %d)"), *Group.AssetPaths[0], Group.AssetPaths.Num() - 1, Group.MaxDistance);
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("FindDuplicateTextures: %d textures hashed, %d duplicate groups found."), NumTextures, Groups.Num());
+    return Groups;
+}
+
+int32 UTextureTools::ConsolidateDuplicateTextures(const TArray<FTextureDuplicateGroup>& Groups)
+{
+    TOOLS_OPERATION_SCOPE("ConsolidateDuplicateTextures");
+
+    int32 RemovedCount = 0;
+
+    for (const FTextureDuplicateGroup& Group : Groups)
+    {
+        if (Group.AssetPaths.Num() < 2)
+        {
+            continue;
+        }
+
+        UObject* Keeper = UEditorAssetLibrary::LoadAsset(Group.AssetPaths[0]);
+        if (!Keeper)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("ConsolidateDuplicateTextures: Failed to load %s, skipping group."), *Group.AssetPaths[0]);
+            continue;
+        }
+
+        // Groups can come from anywhere, never merge textures sampled differently
+        const UTexture2D* KeeperTexture = Cast<UTexture2D>(Keeper);
+        TArray<UObject*> Duplicates;
+        for (int32 Index = 1; Index < Group.AssetPaths.Num(); ++Index)
+        {
+            UTexture2D* Duplicate = Cast<UTexture2D>(UEditorAssetLibrary::LoadAsset(Group.AssetPaths[Index]));
+            if (!Duplicate)
+            {
+                continue;
+            }
+
+            if (!KeeperTexture || TextureToolsPrivate::GetDuplicateSettingsKey(Duplicate) != TextureToolsPrivate::GetDuplicateSettingsKey(KeeperTexture))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("ConsolidateDuplicateTextures: %s does not share the sRGB, compression and LOD group settings of %s, skipping it."),
+                    *Group.AssetPaths[Index], *Group.AssetPaths[0]);
+                continue;
+            }
+
+            Duplicates.Add(Duplicate);
+        }
+
+        if (Duplicates.Num() == 0)
+        {
+            continue;
+        }
+
+        // Redirects every reference to the keeper and deletes the duplicates
+        const int32 NumDuplicates = Duplicates.Num();
+        TOOLS_PHASE_SCOPE("Consolidate", STAT_Tools_Save);
+        const ObjectTools::FConsolidationResults Results = ObjectTools::ConsolidateObjects(Keeper, Duplicates, false);
+        FToolsOperationProfile::CountAssetsScanned(NumDuplicates + 1);
+
+        if (Results.FailedConsolidationObjs.Num() > 0 || Results.InvalidConsolidationObjs.Num() > 0)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("ConsolidateDuplicateTextures: %d of %d textures could not be consolidated onto %s"),
+                Results.FailedConsolidationObjs.Num() + Results.InvalidConsolidationObjs.Num(), NumDuplicates, *Keeper->GetName());
+        }
+
+        const int32 NumConsolidated = NumDuplicates - Results.FailedConsolidationObjs.Num() - Results.InvalidConsolidationObjs.Num();
+        RemovedCount += NumConsolidated;
+
+        UE_LOG(LogTemp, Log, TEXT("ConsolidateDuplicateTextures: Consolidated %d textures onto %s"), NumConsolidated, *Keeper->GetName());
+    }
+
+    return RemovedCount;
+}
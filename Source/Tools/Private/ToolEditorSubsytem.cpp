@@ -8,21 +8,57 @@
 #include "Engine/Texture2D.h"
 #include "AssetToolsModule.h"
 #include "IAssetTools.h"
+#include "AssetRegistry/AssetRegistryModule.h"
 #include "EditorAssetLibrary.h"
 #include "Misc/PackageName.h"
 #include "HAL/FileManager.h"
 #include "Logging/LogMacros.h"
+#include "UObject/ObjectRedirector.h"
+#include "ToolTextureImportRules.h"
+#include "ToolsStats.h"
+#include "ToolsAssetRegistryCache.h"
 
 #define TEXTURE_ROOT_FOLDER TEXT("/Game/Textures")
 
 void UToolEditorSubsytem::Initialize(FSubsystemCollectionBase& Collection)
 {
     FEditorDelegates::OnAssetPostImport.AddUObject(this, &UToolEditorSubsytem::OnAssetPostImport);
+
+    FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+    AssetRegistryModule.Get().OnPathRemoved().AddUObject(this, &UToolEditorSubsytem::OnPathRemoved);
+
+    // Created here so its registry events are bound on the game thread before any tool queries it
+    FToolsAssetRegistryCache::Get();
 }
 
 void UToolEditorSubsytem::Deinitialize()
 {
     FEditorDelegates::OnAssetPostImport.RemoveAll(this);
+
+    if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+    {
+        AssetRegistryModule->Get().OnPathRemoved().RemoveAll(this);
+    }
+
+    if (FlushTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(FlushTickerHandle);
+        FlushTickerHandle.Reset();
+    }
+
+    PendingTextures.Empty();
+}
+
+FString UToolEditorSubsytem::GetTextureBaseName(const FString& TextureName)
+{
+    // Keep the prefix before the first underscore, or the whole name if there is none
+    int32 UnderscoreIndex = INDEX_NONE;
+    if (TextureName.FindChar(TEXT('_'), UnderscoreIndex))
+    {
+        return TextureName.Left(UnderscoreIndex);
+    }
+
+    return TextureName;
 }
 
 void UToolEditorSubsytem::OnAssetPostImport(UFactory* InFactory, UObject* InObject)
@@ -30,61 +66,190 @@ void UToolEditorSubsytem::OnAssetPostImport(UFactory* InFactory, UObject* InObje
     // Only process Texture2D assets
     if (UTexture2D* ImportedTexture = Cast<UTexture2D>(InObject))
     {
-        OrganizeImportedTexture(ImportedTexture);
+        PendingTextures.Add(ImportedTexture);
+
+        // Organize everything imported this frame in one go, once the import has returned
+        if (!FlushTickerHandle.IsValid())
+        {
+            FlushTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UToolEditorSubsytem::OnFlushPendingImports));
+        }
     }
 }
 
-void UToolEditorSubsytem::OrganizeImportedTexture(UTexture2D* ImportedTexture)
+bool UToolEditorSubsytem::OnFlushPendingImports(float DeltaTime)
 {
-    if (!ImportedTexture)
+    FlushTickerHandle.Reset();
+
+    TArray<UTexture2D*> ImportedTextures;
+    ImportedTextures.Reserve(PendingTextures.Num());
+    for (const TWeakObjectPtr<UTexture2D>& Texture : PendingTextures)
     {
-        UE_LOG(LogTemp, Warning, TEXT("OrganizeImportedTexture: Invalid or null texture."));
-        return;
+        if (Texture.IsValid())
+        {
+            ImportedTextures.AddUnique(Texture.Get());
+        }
+    }
+    PendingTextures.Reset();
+
+    OrganizeImportedTextures(ImportedTextures);
+
+    // One-shot ticker
+    return false;
+}
+
+void UToolEditorSubsytem::OnPathRemoved(const FString& Path)
+{
+    KnownFolders.Remove(Path);
+}
+
+void UToolEditorSubsytem::ApplyImportRule(UTexture2D* Texture, const FTextureImportRule& Rule)
+{
+    TOOLS_PHASE_SCOPE("Apply Import Rule", STAT_Tools_TextureProcess);
+
+    Texture->PreEditChange(nullptr);
+
+    Texture->CompressionSettings = Rule.CompressionSettings;
+    Texture->SRGB = Rule.bSRGB;
+    Texture->LODGroup = Rule.LODGroup;
+    Texture->MaxTextureSize = Rule.MaxTextureSize;
+    Texture->MipGenSettings = Rule.MipGenSettings;
+    Texture->VirtualTextureStreaming = Rule.bVirtualTextureStreaming;
+
+    // Rebuilds the platform data with the new settings
+    Texture->PostEditChange();
+    Texture->MarkPackageDirty();
+    FToolsOperationProfile::CountBuilds(1);
+
+    UE_LOG(LogTemp, Log, TEXT("Applied import rule '%s' to texture '%s'"), *Rule.Suffix, *Texture->GetName());
+}
+
+bool UToolEditorSubsytem::EnsureFolderExists(const FString& FolderPath)
+{
+    // Fill the cache once from the registry instead of querying every folder
+    if (!bKnownFoldersCached)
+    {
+        TOOLS_PHASE_SCOPE("Registry Query", STAT_Tools_RegistryQuery);
+        FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+
+        TArray<FString> SubPaths;
+        AssetRegistryModule.Get().GetSubPaths(TEXTURE_ROOT_FOLDER, SubPaths, true);
+
+        KnownFolders.Append(SubPaths);
+        KnownFolders.Add(TEXTURE_ROOT_FOLDER);
+        bKnownFoldersCached = true;
     }
 
-    // Get the name of the texture asset (e.g., "T_Wood_Albedo")
-    const FString TextureName = ImportedTexture->GetName();
+    if (KnownFolders.Contains(FolderPath))
+    {
+        return true;
+    }
 
-    // Remove known suffixes (_Albedo, _Roughness, etc.) if present
-    FString BaseName;
-    if (TextureName.Split(TEXT("_"), nullptr, &BaseName))
+    if (!UEditorAssetLibrary::MakeDirectory(FolderPath))
     {
-        BaseName = TextureName.Left(TextureName.Find(TEXT("_")));
+        UE_LOG(LogTemp, Warning, TEXT("Failed to create folder: %s"), *FolderPath);
+        return false;
     }
-    else
+
+    UE_LOG(LogTemp, Log, TEXT("Created folder: %s"), *FolderPath);
+    KnownFolders.Add(FolderPath);
+    return true;
+}
+
+void UToolEditorSubsytem::OrganizeImportedTextures(const TArray<UTexture2D*>& ImportedTextures)
+{
+    if (ImportedTextures.Num() == 0)
     {
-        BaseName = TextureName; // fallback if no underscore
+        return;
     }
 
-    // Construct the full path of the destination folder
-    const FString TargetFolderPath = FString::Printf(TEXT("%s/%s"), TEXTURE_ROOT_FOLDER, *BaseName);
+    TOOLS_OPERATION_SCOPE("OrganizeImportedTextures");
+    FToolsOperationProfile::CountAssetsScanned(ImportedTextures.Num());
+
+    const UToolTextureImportRules* ImportRules = GetDefault<UToolTextureImportRules>();
+
+    TArray<FAssetRenameData> RenameData;
+    TArray<FString> OldObjectPaths;
+    TSet<FString> DestinationFolders;
 
-    // Create the folder if it doesn't already exist
-    if (!UEditorAssetLibrary::DoesDirectoryExist(TargetFolderPath))
+    for (UTexture2D* ImportedTexture : ImportedTextures)
     {
-        const bool bCreated = UEditorAssetLibrary::MakeDirectory(TargetFolderPath);
-        if (bCreated)
+        // Get the name of the texture asset (e.g., "T_Wood_Albedo")
+        const FString TextureName = ImportedTexture->GetName();
+
+        const FString BaseName = GetTextureBaseName(TextureName);
+
+        // Set the texture up from the matching rule before it is first saved
+        const FTextureImportRule* Rule = ImportRules->FindRule(TextureName);
+        if (Rule)
         {
-            UE_LOG(LogTemp, Log, TEXT("Created folder: %s"), *TargetFolderPath);
+            ApplyImportRule(ImportedTexture, *Rule);
         }
-        else
+
+        // Construct the full path of the destination folder
+        FString TargetFolderPath = FString::Printf(TEXT("%s/%s"), TEXTURE_ROOT_FOLDER, *BaseName);
+        if (Rule && !Rule->DestinationFolder.IsEmpty())
         {
-            UE_LOG(LogTemp, Warning, TEXT("Failed to create folder: %s"), *TargetFolderPath);
-            return;
+            const FString RuleFolderPath = Rule->DestinationFolder.Replace(TEXT("{Base}"), *BaseName);
+
+            FText Reason;
+            if (FPackageName::IsValidLongPackageName(RuleFolderPath, false, &Reason))
+            {
+                TargetFolderPath = RuleFolderPath;
+            }
+            else
+            {
+                UE_LOG(LogTemp, Warning, TEXT("Invalid destination folder '%s' in the '%s' import rule (%s), using '%s'"), *RuleFolderPath, *Rule->Suffix, *Reason.ToString(), *TargetFolderPath);
+            }
         }
+
+        // Reimported textures are already in place
+        if (FPackageName::GetLongPackagePath(ImportedTexture->GetOutermost()->GetName()) == TargetFolderPath)
+        {
+            continue;
+        }
+
+        if (!EnsureFolderExists(TargetFolderPath))
+        {
+            continue;
+        }
+
+        OldObjectPaths.Add(ImportedTexture->GetPathName());
+        RenameData.Emplace(ImportedTexture, TargetFolderPath, TextureName);
+        DestinationFolders.Add(TargetFolderPath);
+        FToolsOperationProfile::CountBytesTouched(ImportedTexture->GetResourceSizeBytes(EResourceSizeMode::Exclusive));
+    }
+
+    if (RenameData.Num() == 0)
+    {
+        return;
     }
 
-    // Build full old and new object paths
-    const FString OldPath = ImportedTexture->GetPathName();
-    const FString NewObjectPath = TargetFolderPath + TEXT("/") + TextureName;
+    // Move every texture with one rename operation
+    IAssetTools& AssetTools = FModuleManager::LoadModuleChecked<FAssetToolsModule>("AssetTools").Get();
+    {
+        TOOLS_PHASE_SCOPE("Rename", STAT_Tools_Rename);
+        if (!AssetTools.RenameAssets(RenameData))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Failed to move some of the %d imported textures, see the rename log for details"), RenameData.Num());
+        }
+    }
 
-    // Move the asset to the new folder
-    if (UEditorAssetLibrary::RenameAsset(OldPath, NewObjectPath))
+    // Fix up the redirectors left behind by the whole batch at once
+    TArray<UObjectRedirector*> Redirectors;
+    for (const FString& OldObjectPath : OldObjectPaths)
     {
-        UE_LOG(LogTemp, Log, TEXT("Successfully moved texture '%s' to '%s'"), *TextureName, *TargetFolderPath);
+        if (UObjectRedirector* Redirector = FindObject<UObjectRedirector>(nullptr, *OldObjectPath))
+        {
+            Redirectors.Add(Redirector);
+        }
     }
-    else
+
+    if (Redirectors.Num() > 0)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Failed to move texture '%s' to '%s'"), *TextureName, *TargetFolderPath);
+        TOOLS_PHASE_SCOPE("Fixup Referencers", STAT_Tools_Save);
+        AssetTools.FixupReferencers(Redirectors, false);
+        FToolsOperationProfile::CountSaves(Redirectors.Num());
     }
-}
\ No newline at end of file
+
+    UE_LOG(LogTemp, Log, TEXT("Successfully organized %d imported textures under '%s'"), RenameData.Num(), *FString::Join(DestinationFolders.Array(), TEXT("', '")));
+}
@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ToolTextureImportRules.h"
+
+UToolTextureImportRules::UToolTextureImportRules()
+{
+    CategoryName = TEXT("Editor");
+    SectionName = TEXT("TextureImportRules");
+}
+
+const FTextureImportRule* UToolTextureImportRules::FindRule(const FString& TextureName) const
+{
+    if (!bApplyRules)
+    {
+        return nullptr;
+    }
+
+    // Several suffixes can match one name ("_Color" and "_BaseColor"), the longest is the most specific
+    const FTextureImportRule* BestRule = nullptr;
+    for (const FTextureImportRule& Rule : Rules)
+    {
+        if (!Rule.Suffix.IsEmpty() && TextureName.EndsWith(Rule.Suffix, ESearchCase::IgnoreCase))
+        {
+            if (!BestRule || Rule.Suffix.Len() > BestRule->Suffix.Len())
+            {
+                BestRule = &Rule;
+            }
+        }
+    }
+
+    return BestRule;
+}
@@ -0,0 +1,198 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ToolsAssetRegistryCache.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Misc/CoreDelegates.h"
+#include "ToolsStats.h"
+
+FToolsAssetRegistryCache& FToolsAssetRegistryCache::Get()
+{
+    static FToolsAssetRegistryCache Cache;
+    return Cache;
+}
+
+FToolsAssetRegistryCache::FToolsAssetRegistryCache()
+{
+    check(IsInGameThread());
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+    RegistryHandles.Add(AssetRegistry.OnAssetAdded().AddLambda([this](const FAssetData&) { Invalidate(); }));
+    RegistryHandles.Add(AssetRegistry.OnAssetRemoved().AddLambda([this](const FAssetData&) { Invalidate(); }));
+    RegistryHandles.Add(AssetRegistry.OnAssetUpdated().AddLambda([this](const FAssetData&) { Invalidate(); }));
+    RegistryHandles.Add(AssetRegistry.OnAssetUpdatedOnDisk().AddLambda([this](const FAssetData&) { Invalidate(); }));
+    RegistryHandles.Add(AssetRegistry.OnAssetRenamed().AddLambda([this](const FAssetData&, const FString&) { Invalidate(); }));
+
+    FCoreDelegates::OnEnginePreExit.AddRaw(this, &FToolsAssetRegistryCache::UnbindRegistryEvents);
+}
+
+void FToolsAssetRegistryCache::UnbindRegistryEvents()
+{
+    if (RegistryHandles.Num() == 0)
+    {
+        return;
+    }
+
+    if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+    {
+        IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+        AssetRegistry.OnAssetAdded().Remove(RegistryHandles[0]);
+        AssetRegistry.OnAssetRemoved().Remove(RegistryHandles[1]);
+        AssetRegistry.OnAssetUpdated().Remove(RegistryHandles[2]);
+        AssetRegistry.OnAssetUpdatedOnDisk().Remove(RegistryHandles[3]);
+        AssetRegistry.OnAssetRenamed().Remove(RegistryHandles[4]);
+    }
+
+    RegistryHandles.Reset();
+    FCoreDelegates::OnEnginePreExit.RemoveAll(this);
+    Invalidate();
+}
+
+IAssetRegistry& FToolsAssetRegistryCache::GetRegistry()
+{
+    // Unlike LoadModuleChecked, safe from worker threads once the module is up
+    return IAssetRegistry::GetChecked();
+}
+
+template<typename KeyType, typename ValueType, typename QueryType>
+ValueType FToolsAssetRegistryCache::FindOrQuery(TMap<KeyType, ValueType>& Map, const KeyType& Key, QueryType&& Query)
+{
+    uint32 QueryGeneration = 0;
+    {
+        FReadScopeLock ReadLock(Lock);
+        if (const ValueType* Found = Map.Find(Key))
+        {
+            return *Found;
+        }
+        QueryGeneration = Generation;
+    }
+
+    ValueType Result = [&Query]()
+    {
+        SCOPE_CYCLE_COUNTER(STAT_Tools_RegistryQuery);
+        return Query();
+    }();
+
+    // Partial results during the startup scan would be invalidated right away
+    if (!GetRegistry().IsLoadingAssets())
+    {
+        FWriteScopeLock WriteLock(Lock);
+        if (Generation == QueryGeneration)
+        {
+            Map.Add(Key, Result);
+        }
+    }
+
+    return Result;
+}
+
+FToolsAssetRegistryCache::FAssetList FToolsAssetRegistryCache::GetAssets(const FARFilter& Filter)
+{
+    auto Query = [&Filter]() -> FAssetList
+    {
+        TArray<FAssetData> Assets;
+        GetRegistry().GetAssets(Filter, Assets);
+        return MakeShared<const TArray<FAssetData>, ESPMode::ThreadSafe>(MoveTemp(Assets));
+    };
+
+    const FString Key = MakeFilterKey(Filter);
+    return Key.IsEmpty() ? Query() : FindOrQuery(AssetsByFilter, Key, Query);
+}
+
+FToolsAssetRegistryCache::FAssetList FToolsAssetRegistryCache::GetAssetsByPackageName(FName PackageName)
+{
+    return FindOrQuery(AssetsByPackage, PackageName, [PackageName]() -> FAssetList
+    {
+        TArray<FAssetData> Assets;
+        GetRegistry().GetAssetsByPackageName(PackageName, Assets);
+        return MakeShared<const TArray<FAssetData>, ESPMode::ThreadSafe>(MoveTemp(Assets));
+    });
+}
+
+FAssetData FToolsAssetRegistryCache::GetAssetByObjectPath(const FSoftObjectPath& ObjectPath)
+{
+    return FindOrQuery(AssetsByObjectPath, ObjectPath, [&ObjectPath]()
+    {
+        return GetRegistry().GetAssetByObjectPath(ObjectPath);
+    });
+}
+
+TArray<FName> FToolsAssetRegistryCache::GetReferencers(FName PackageName)
+{
+    return FindOrQuery(Referencers, PackageName, [PackageName]()
+    {
+        TArray<FName> Result;
+        GetRegistry().GetReferencers(PackageName, Result);
+        return Result;
+    });
+}
+
+TArray<FName> FToolsAssetRegistryCache::GetHardDependencies(FName PackageName)
+{
+    return FindOrQuery(HardDependencies, PackageName, [PackageName]()
+    {
+        TArray<FName> Result;
+        GetRegistry().GetDependencies(PackageName, Result, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+        return Result;
+    });
+}
+
+int64 FToolsAssetRegistryCache::GetPackageDiskSize(FName PackageName)
+{
+    return FindOrQuery(PackageDiskSizes, PackageName, [PackageName]()
+    {
+        const TOptional<FAssetPackageData> PackageData = GetRegistry().GetAssetPackageDataCopy(PackageName);
+        return PackageData.IsSet() ? FMath::Max<int64>(PackageData->DiskSize, 0) : int64(0);
+    });
+}
+
+void FToolsAssetRegistryCache::Invalidate()
+{
+    FWriteScopeLock WriteLock(Lock);
+    ++Generation;
+
+    if (AssetsByFilter.Num() + AssetsByPackage.Num() + AssetsByObjectPath.Num() + Referencers.Num() + HardDependencies.Num() + PackageDiskSizes.Num() == 0)
+    {
+        return;
+    }
+
+    AssetsByFilter.Reset();
+    AssetsByPackage.Reset();
+    AssetsByObjectPath.Reset();
+    Referencers.Reset();
+    HardDependencies.Reset();
+    PackageDiskSizes.Reset();
+}
+
+FString FToolsAssetRegistryCache::MakeFilterKey(const FARFilter& Filter)
+{
+    if (Filter.TagsAndValues.Num() > 0)
+    {
+        return FString();
+    }
+
+    TStringBuilder<256> Key;
+    Key << (Filter.bRecursivePaths ? TEXT("R") : TEXT("-")) << (Filter.bRecursiveClasses ? TEXT("R") : TEXT("-")) << (Filter.bIncludeOnlyOnDiskAssets ? TEXT("D") : TEXT("-"));
+    for (const FName& Name : Filter.PackageNames)
+    {
+        Key << TEXT("|n") << Name;
+    }
+    for (const FName& Path : Filter.PackagePaths)
+    {
+        Key << TEXT("|p") << Path;
+    }
+    for (const FSoftObjectPath& ObjectPath : Filter.SoftObjectPaths)
+    {
+        Key << TEXT("|o") << ObjectPath.ToString();
+    }
+    for (const FTopLevelAssetPath& ClassPath : Filter.ClassPaths)
+    {
+        Key << TEXT("|c") << ClassPath.ToString();
+    }
+    for (const FTopLevelAssetPath& ClassPath : Filter.RecursiveClassPathsExclusionSet)
+    {
+        Key << TEXT("|x") << ClassPath.ToString();
+    }
+    return FString(Key.ToView());
+}
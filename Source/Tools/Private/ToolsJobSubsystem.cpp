@@ -0,0 +1,409 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ToolsJobSubsystem.h"
+#include "SToolsJobPanel.h"
+#include "Editor.h"
+#include "Framework/Docking/TabManager.h"
+#include "Widgets/Docking/SDockTab.h"
+#include "WorkspaceMenuStructure.h"
+#include "WorkspaceMenuStructureModule.h"
+#include "Tasks/Task.h"
+#include "HAL/PlatformTime.h"
+
+#define LOCTEXT_NAMESPACE "ToolsJobSubsystem"
+
+static const FName ToolsJobsTabName("ToolsJobs");
+
+void FToolsJobContext::Fail(const FString& Message)
+{
+    {
+        FScopeLock Lock(&ErrorLock);
+        Error = Message;
+    }
+    bFailed.store(true);
+}
+
+FToolsJobPhase FToolsJobPhase::Worker(const FString& InName, TFunction<void(FToolsJobContext&)> InWork)
+{
+    FToolsJobPhase Phase;
+    Phase.Name = InName;
+    Phase.WorkerWork = MoveTemp(InWork);
+    return Phase;
+}
+
+FToolsJobPhase FToolsJobPhase::GameThread(const FString& InName, TFunction<bool(FToolsJobContext&)> InStep)
+{
+    FToolsJobPhase Phase;
+    Phase.Name = InName;
+    Phase.GameThreadStep = MoveTemp(InStep);
+    return Phase;
+}
+
+void UToolsJobSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    FGlobalTabmanager::Get()->RegisterNomadTabSpawner(ToolsJobsTabName, FOnSpawnTab::CreateUObject(this, &UToolsJobSubsystem::SpawnJobsTab))
+        .SetDisplayName(LOCTEXT("TabTitle", "Tools Jobs"))
+        .SetTooltipText(LOCTEXT("TabTooltip", "Progress and history of background tool operations."))
+        .SetGroup(WorkspaceMenu::GetMenuStructure().GetToolsCategory());
+}
+
+void UToolsJobSubsystem::Deinitialize()
+{
+    FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(ToolsJobsTabName);
+
+    // Worker phases capture their context, not the subsystem, but must not outlive the editor
+    CancelAllJobs();
+    for (const TSharedRef<FJob>& Job : ActiveJobs)
+    {
+        if (Job->bWorkerLaunched)
+        {
+            Job->WorkerTask.Wait();
+        }
+    }
+    ActiveJobs.Empty();
+}
+
+UToolsJobSubsystem* UToolsJobSubsystem::Get()
+{
+    return GEditor ? GEditor->GetEditorSubsystem<UToolsJobSubsystem>() : nullptr;
+}
+
+void UToolsJobSubsystem::OpenJobsPanel()
+{
+    FGlobalTabmanager::Get()->TryInvokeTab(FTabId(ToolsJobsTabName));
+}
+
+int32 UToolsJobSubsystem::SubmitJob(const FString& Name, TArray<FToolsJobPhase> Phases, const TArray<int32>& Dependencies, TFunction<void(EToolsJobState)> OnFinished)
+{
+    TSharedRef<FJob> Job = MakeShared<FJob>();
+    Job->Id = NextJobId++;
+    Job->Name = Name;
+    Job->Phases = MoveTemp(Phases);
+    Job->Dependencies = Dependencies;
+    Job->OnFinished = MoveTemp(OnFinished);
+    ActiveJobs.Add(Job);
+
+    UE_LOG(LogTemp, Log, TEXT("ToolsJobs: Queued job %d '%s' (%d phases)"), Job->Id, *Name, Job->Phases.Num());
+    return Job->Id;
+}
+
+void UToolsJobSubsystem::CancelJob(int32 JobId)
+{
+    for (const TSharedRef<FJob>& Job : ActiveJobs)
+    {
+        if (Job->Id == JobId)
+        {
+            Job->Context->bCancelRequested.store(true);
+        }
+    }
+}
+
+void UToolsJobSubsystem::CancelAllJobs()
+{
+    for (const TSharedRef<FJob>& Job : ActiveJobs)
+    {
+        Job->Context->bCancelRequested.store(true);
+    }
+}
+
+FToolsJobRecord UToolsJobSubsystem::GetJob(int32 JobId) const
+{
+    for (const TSharedRef<FJob>& Job : ActiveJobs)
+    {
+        if (Job->Id == JobId)
+        {
+            return MakeRecord(*Job);
+        }
+    }
+
+    const FToolsJobRecord* Record = History.FindByPredicate([JobId](const FToolsJobRecord& Candidate) { return Candidate.JobId == JobId; });
+    return Record ? *Record : FToolsJobRecord();
+}
+
+TArray<FToolsJobRecord> UToolsJobSubsystem::GetJobs() const
+{
+    TArray<FToolsJobRecord> Records;
+    Records.Reserve(ActiveJobs.Num() + History.Num());
+
+    for (const TSharedRef<FJob>& Job : ActiveJobs)
+    {
+        Records.Add(MakeRecord(*Job));
+    }
+
+    for (int32 Index = History.Num() - 1; Index >= 0; --Index)
+    {
+        Records.Add(History[Index]);
+    }
+
+    return Records;
+}
+
+TStatId UToolsJobSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UToolsJobSubsystem, STATGROUP_Tickables);
+}
+
+void UToolsJobSubsystem::Tick(float DeltaTime)
+{
+    if (ActiveJobs.Num() == 0)
+    {
+        return;
+    }
+
+    StartReadyJobs();
+    UpdateWorkerPhases();
+    RunGameThreadSlices();
+
+    // Finished jobs leave the active list here, never while iterating over it
+    TArray<TSharedRef<FJob>> FinishedJobs;
+    for (int32 Index = 0; Index < ActiveJobs.Num(); ++Index)
+    {
+        const TSharedRef<FJob>& Job = ActiveJobs[Index];
+        if (Job->State != EToolsJobState::Pending && Job->State != EToolsJobState::Running)
+        {
+            History.Add(MakeRecord(*Job));
+            FinishedStates.Add(Job->Id, Job->State);
+            FinishedJobs.Add(Job);
+            ActiveJobs.RemoveAt(Index--);
+        }
+    }
+
+    if (History.Num() > MaxHistory)
+    {
+        History.RemoveAt(0, History.Num() - MaxHistory);
+    }
+
+    // Callbacks last, they may submit new jobs
+    for (const TSharedRef<FJob>& Job : FinishedJobs)
+    {
+        if (Job->OnFinished)
+        {
+            Job->OnFinished(Job->State);
+        }
+    }
+}
+
+EToolsJobState UToolsJobSubsystem::FindJobState(int32 JobId) const
+{
+    for (const TSharedRef<FJob>& Job : ActiveJobs)
+    {
+        if (Job->Id == JobId)
+        {
+            return Job->State;
+        }
+    }
+
+    // Outlives the history trimming, so dependents of old jobs still see how they ended
+    if (const EToolsJobState* State = FinishedStates.Find(JobId))
+    {
+        return *State;
+    }
+
+    // Never submitted, waiting on it would block the dependent forever
+    return EToolsJobState::Failed;
+}
+
+void UToolsJobSubsystem::StartReadyJobs()
+{
+    for (const TSharedRef<FJob>& JobRef : ActiveJobs)
+    {
+        FJob& Job = *JobRef;
+        if (Job.State != EToolsJobState::Pending)
+        {
+            continue;
+        }
+
+        if (Job.Context->IsCancelled())
+        {
+            FinishJob(Job, EToolsJobState::Cancelled);
+            continue;
+        }
+
+        bool bReady = true;
+        for (int32 Dependency : Job.Dependencies)
+        {
+            const EToolsJobState DependencyState = FindJobState(Dependency);
+            if (DependencyState == EToolsJobState::Failed || DependencyState == EToolsJobState::Cancelled)
+            {
+                Job.Context->Fail(FString::Printf(TEXT("Dependency %d did not succeed"), Dependency));
+                FinishJob(Job, EToolsJobState::Cancelled);
+                bReady = false;
+                break;
+            }
+
+            bReady &= DependencyState == EToolsJobState::Succeeded;
+        }
+
+        if (bReady && Job.State == EToolsJobState::Pending)
+        {
+            Job.State = EToolsJobState::Running;
+            Job.StartSeconds = FPlatformTime::Seconds();
+
+            if (Job.Phases.Num() == 0)
+            {
+                FinishJob(Job, EToolsJobState::Succeeded);
+            }
+        }
+    }
+}
+
+void UToolsJobSubsystem::UpdateWorkerPhases()
+{
+    for (const TSharedRef<FJob>& JobRef : ActiveJobs)
+    {
+        FJob& Job = *JobRef;
+        if (Job.State != EToolsJobState::Running || !Job.Phases[Job.PhaseIndex].WorkerWork)
+        {
+            continue;
+        }
+
+        if (!Job.bWorkerLaunched)
+        {
+            if (Job.Context->IsCancelled())
+            {
+                FinishJob(Job, EToolsJobState::Cancelled);
+                continue;
+            }
+
+            // The task owns a reference to the context and the work, so it can finish after the job is gone
+            TSharedRef<FToolsJobContext> Context = Job.Context;
+            TFunction<void(FToolsJobContext&)> Work = Job.Phases[Job.PhaseIndex].WorkerWork;
+            Job.WorkerTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Context, Work]()
+            {
+                Work(*Context);
+            });
+            Job.bWorkerLaunched = true;
+        }
+        else if (Job.WorkerTask.IsCompleted())
+        {
+            Job.bWorkerLaunched = false;
+            AdvancePhase(Job);
+        }
+    }
+}
+
+void UToolsJobSubsystem::RunGameThreadSlices()
+{
+    TArray<FJob*> SlicedJobs;
+    for (const TSharedRef<FJob>& Job : ActiveJobs)
+    {
+        if (Job->State == EToolsJobState::Running && Job->Phases[Job->PhaseIndex].GameThreadStep)
+        {
+            SlicedJobs.Add(&Job.Get());
+        }
+    }
+
+    if (SlicedJobs.Num() == 0)
+    {
+        return;
+    }
+
+    // At least one step per frame, then as many as fit in the budget
+    const double Deadline = FPlatformTime::Seconds() + FrameBudgetMs / 1000.0;
+    const int32 FirstJob = RoundRobinOffset++ % SlicedJobs.Num();
+
+    bool bAnyStepped = true;
+    while (bAnyStepped)
+    {
+        bAnyStepped = false;
+        for (int32 Offset = 0; Offset < SlicedJobs.Num(); ++Offset)
+        {
+            FJob& Job = *SlicedJobs[(FirstJob + Offset) % SlicedJobs.Num()];
+            if (Job.State != EToolsJobState::Running || !Job.Phases[Job.PhaseIndex].GameThreadStep)
+            {
+                continue;
+            }
+
+            if (Job.Context->IsCancelled())
+            {
+                FinishJob(Job, EToolsJobState::Cancelled);
+                continue;
+            }
+
+            if (Job.Phases[Job.PhaseIndex].GameThreadStep(*Job.Context) || Job.Context->bFailed.load())
+            {
+                AdvancePhase(Job);
+            }
+            bAnyStepped = true;
+
+            if (FPlatformTime::Seconds() >= Deadline)
+            {
+                return;
+            }
+        }
+    }
+}
+
+void UToolsJobSubsystem::AdvancePhase(FJob& Job)
+{
+    if (Job.Context->bFailed.load())
+    {
+        FinishJob(Job, EToolsJobState::Failed);
+        return;
+    }
+
+    if (Job.Context->IsCancelled())
+    {
+        FinishJob(Job, EToolsJobState::Cancelled);
+        return;
+    }
+
+    Job.Context->PhaseProgress.store(0.0f);
+    if (++Job.PhaseIndex >= Job.Phases.Num())
+    {
+        Job.PhaseIndex = Job.Phases.Num() - 1;
+        FinishJob(Job, EToolsJobState::Succeeded);
+    }
+}
+
+void UToolsJobSubsystem::FinishJob(FJob& Job, EToolsJobState State)
+{
+    Job.State = State;
+    if (State == EToolsJobState::Succeeded)
+    {
+        Job.Context->PhaseProgress.store(1.0f);
+    }
+
+    const FToolsJobRecord Record = MakeRecord(Job);
+    UE_LOG(LogTemp, Log, TEXT("ToolsJobs: Job %d '%s' %s after %.2f s%s%s"), Job.Id, *Job.Name,
+        *StaticEnum<EToolsJobState>()->GetNameStringByValue((int64)State), Record.Seconds,
+        Record.Error.IsEmpty() ? TEXT("") : TEXT(": "), *Record.Error);
+}
+
+FToolsJobRecord UToolsJobSubsystem::MakeRecord(const FJob& Job) const
+{
+    FToolsJobRecord Record;
+    Record.JobId = Job.Id;
+    Record.Name = Job.Name;
+    Record.State = Job.State;
+
+    if (Job.Phases.IsValidIndex(Job.PhaseIndex))
+    {
+        Record.Phase = Job.Phases[Job.PhaseIndex].Name;
+    }
+
+    const float PhaseProgress = Job.Context->PhaseProgress.load();
+    Record.Progress = Job.Phases.Num() > 0 ? (Job.PhaseIndex + PhaseProgress) / Job.Phases.Num() : 1.0f;
+    if (Job.State == EToolsJobState::Succeeded)
+    {
+        Record.Progress = 1.0f;
+    }
+
+    Record.Seconds = Job.StartSeconds > 0.0 ? float(FPlatformTime::Seconds() - Job.StartSeconds) : 0.0f;
+
+    FScopeLock Lock(&Job.Context->ErrorLock);
+    Record.Error = Job.Context->Error;
+    return Record;
+}
+
+TSharedRef<SDockTab> UToolsJobSubsystem::SpawnJobsTab(const FSpawnTabArgs& Args)
+{
+    return SNew(SDockTab)
+        .TabRole(ETabRole::NomadTab)
+        [
+            SNew(SToolsJobPanel)
+        ];
+}
+
+#undef LOCTEXT_NAMESPACE
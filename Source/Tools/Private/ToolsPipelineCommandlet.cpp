@@ -0,0 +1,415 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ToolsPipelineCommandlet.h"
+#include "MeshTools.h"
+#include "MeshToolsCache.h"
+#include "ToolsAssetRegistryCache.h"
+#include "AutoCleanupTool.h"
+#include "ToolsStats.h"
+#include "Engine/StaticMesh.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "EditorAssetLibrary.h"
+#include "StaticMeshCompiler.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/Crc.h"
+#include "JsonObjectConverter.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace ToolsPipelinePrivate
+{
+    const TCHAR* const JournalHeader = TEXT("#pipeline ");
+
+    enum class EStepResult : uint8
+    {
+        Done,
+        Skipped,
+        Failed,
+    };
+
+    const TCHAR* LexToString(EStepResult Result)
+    {
+        switch (Result)
+        {
+        case EStepResult::Done: return TEXT("Done");
+        case EStepResult::Skipped: return TEXT("Skipped");
+        default: return TEXT("Failed");
+        }
+    }
+
+    bool IsGlobalStep(const FToolsPipelineStep& Step)
+    {
+        return Step.Operation == TEXT("MoveUnusedAssets");
+    }
+
+    bool IsKnownStep(const FToolsPipelineStep& Step)
+    {
+        static const TCHAR* const Operations[] = { TEXT("GenerateLODs"), TEXT("ClearLODs"), TEXT("GenerateSimpleCollision"), TEXT("ReplaceMaterial"), TEXT("MoveUnusedAssets") };
+        for (const TCHAR* Operation : Operations)
+        {
+            if (Step.Operation == Operation)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /** Appends lines to a file and flushes each one, so a crash loses at most the line being written */
+    class FLineWriter
+    {
+    public:
+        bool Open(const FString& FilePath, bool bAppend)
+        {
+            Archive.Reset(IFileManager::Get().CreateFileWriter(*FilePath, (bAppend ? FILEWRITE_Append : 0) | FILEWRITE_AllowRead));
+            return Archive.IsValid();
+        }
+
+        void WriteLine(const FString& Line)
+        {
+            FTCHARToUTF8 Utf8(*(Line + LINE_TERMINATOR));
+            Archive->Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Utf8.Length());
+            Archive->Flush();
+        }
+
+    private:
+        TUniquePtr<FArchive> Archive;
+    };
+
+    /**
+     * Reads the packages completed by a previous run, returns false if the journal belongs to another pipeline.
+     * Failed entries are left out so the resumed run retries them, the last line of a key wins.
+     */
+    bool LoadJournal(const FString& FilePath, uint32 PipelineHash, TSet<FString>& OutCompleted)
+    {
+        TArray<FString> Lines;
+        if (!FFileHelper::LoadFileToStringArray(Lines, *FilePath) || Lines.Num() == 0)
+        {
+            return false;
+        }
+
+        if (Lines[0] != FString::Printf(TEXT("%s%08x"), JournalHeader, PipelineHash))
+        {
+            return false;
+        }
+
+        for (int32 Index = 1; Index < Lines.Num(); ++Index)
+        {
+            FString Key;
+            FString Result;
+            if (!Lines[Index].Split(TEXT("\t"), &Key, &Result))
+            {
+                continue;
+            }
+
+            if (Result == TEXT("Done"))
+            {
+                OutCompleted.Add(Key);
+            }
+            else
+            {
+                OutCompleted.Remove(Key);
+            }
+        }
+        return true;
+    }
+
+    TArray<FAssetData> GatherAssets(const FToolsPipelineFilter& Filter)
+    {
+        FARFilter ARFilter;
+        ARFilter.bRecursivePaths = true;
+        for (const FString& Path : Filter.Paths)
+        {
+            ARFilter.PackagePaths.Add(FName(*Path));
+        }
+        for (const FString& ClassPath : Filter.ClassPaths)
+        {
+            ARFilter.ClassPaths.Add(FTopLevelAssetPath(ClassPath));
+        }
+
+        // Copied, the list is filtered and sorted below
+        TArray<FAssetData> Assets = *FToolsAssetRegistryCache::Get().GetAssets(ARFilter);
+
+        Assets.RemoveAll([&Filter](const FAssetData& Asset)
+        {
+            const FString AssetPath = Asset.PackagePath.ToString();
+            const bool bIsExcluded = Filter.ExcludedPaths.ContainsByPredicate([&AssetPath](const FString& Excluded)
+            {
+                return AssetPath.StartsWith(Excluded);
+            });
+            return bIsExcluded || (!Filter.NameContains.IsEmpty() && !Asset.AssetName.ToString().Contains(Filter.NameContains));
+        });
+
+        // Stable order so batches and the journal line up between runs
+        Assets.Sort([](const FAssetData& A, const FAssetData& B)
+        {
+            return A.PackageName.LexicalLess(B.PackageName);
+        });
+
+        FToolsOperationProfile::CountAssetsScanned(Assets.Num());
+        return Assets;
+    }
+
+    EStepResult RunAssetStep(const FToolsPipelineStep& Step, UObject* Asset, FString& OutDetail)
+    {
+        UStaticMesh* Mesh = Cast<UStaticMesh>(Asset);
+        if (!Mesh)
+        {
+            OutDetail = TEXT("Not a static mesh");
+            return EStepResult::Skipped;
+        }
+
+        // LODs and collision go through FMeshToolsCache, unchanged meshes are skipped
+        if (Step.Operation == TEXT("GenerateLODs"))
+        {
+            int32 NumGenerated = 0;
+            for (int32 Index = 0; Index < Step.LODs.Num(); ++Index)
+            {
+                NumGenerated += UMeshTools::GenerateLODsForMeshIncremental(Mesh, Index + 1, Step.LODs[Index]) ? 1 : 0;
+            }
+            OutDetail = FString::Printf(TEXT("%d LODs, %d generated"), Mesh->GetNumSourceModels(), NumGenerated);
+            return NumGenerated > 0 ? EStepResult::Done : EStepResult::Skipped;
+        }
+
+        if (Step.Operation == TEXT("ClearLODs"))
+        {
+            UMeshTools::ClearLODs(Mesh);
+            return EStepResult::Done;
+        }
+
+        if (Step.Operation == TEXT("GenerateSimpleCollision"))
+        {
+            if (!UMeshTools::GenerateSimpleCollisionIncremental(Mesh))
+            {
+                OutDetail = TEXT("Up to date");
+                return EStepResult::Skipped;
+            }
+            return EStepResult::Done;
+        }
+
+        if (Step.Operation == TEXT("ReplaceMaterial"))
+        {
+            const int32 Modified = UMeshTools::ReplaceMaterialBatch({ Mesh }, Step.MaterialToReplace, Step.NewMaterial);
+            return Modified > 0 ? EStepResult::Done : EStepResult::Skipped;
+        }
+
+        OutDetail = FString::Printf(TEXT("Unknown operation %s"), *Step.Operation);
+        return EStepResult::Failed;
+    }
+
+    FString EscapeCsv(const FString& Value)
+    {
+        return Value.Contains(TEXT(",")) || Value.Contains(TEXT("\"")) ? FString::Printf(TEXT("\"%s\""), *Value.Replace(TEXT("\""), TEXT("\"\""))) : Value;
+    }
+}
+
+UToolsPipelineCommandlet::UToolsPipelineCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UToolsPipelineCommandlet::Main(const FString& Params)
+{
+    using namespace ToolsPipelinePrivate;
+
+    TOOLS_OPERATION_SCOPE("ToolsPipeline");
+
+    FString PipelinePath;
+    if (!FParse::Value(*Params, TEXT("Pipeline="), PipelinePath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("ToolsPipeline: Missing -Pipeline=<file.json>"));
+        return 1;
+    }
+
+    FString PipelineJson;
+    FToolsPipelineDesc Pipeline;
+    if (!FFileHelper::LoadFileToString(PipelineJson, *PipelinePath) || !FJsonObjectConverter::JsonObjectStringToUStruct(PipelineJson, &Pipeline))
+    {
+        UE_LOG(LogTemp, Error, TEXT("ToolsPipeline: Failed to read pipeline %s"), *PipelinePath);
+        return 1;
+    }
+
+    if (Pipeline.Name.IsEmpty())
+    {
+        Pipeline.Name = FPaths::GetBaseFilename(PipelinePath);
+    }
+    FParse::Value(*Params, TEXT("BatchSize="), Pipeline.BatchSize);
+    Pipeline.BatchSize = FMath::Max(Pipeline.BatchSize, 1);
+
+    for (const FToolsPipelineStep& Step : Pipeline.Steps)
+    {
+        if (!IsKnownStep(Step))
+        {
+            UE_LOG(LogTemp, Error, TEXT("ToolsPipeline: Unknown operation '%s' in %s"), *Step.Operation, *PipelinePath);
+            return 1;
+        }
+    }
+
+    // Resume only a journal written by the same pipeline description
+    const FString OutputDir = FPaths::ProjectSavedDir() / TEXT("Pipeline");
+    const FString JournalPath = OutputDir / Pipeline.Name + TEXT(".journal");
+    const FString ResultPath = OutputDir / Pipeline.Name + TEXT(".csv");
+    const uint32 PipelineHash = FCrc::StrCrc32(*PipelineJson);
+
+    TSet<FString> Completed;
+    const bool bResume = !FParse::Param(*Params, TEXT("Restart")) && LoadJournal(JournalPath, PipelineHash, Completed);
+
+    FLineWriter Journal;
+    FLineWriter ResultLog;
+    if (!Journal.Open(JournalPath, bResume) || !ResultLog.Open(ResultPath, bResume))
+    {
+        UE_LOG(LogTemp, Error, TEXT("ToolsPipeline: Failed to open %s"), *OutputDir);
+        return 1;
+    }
+
+    if (bResume)
+    {
+        UE_LOG(LogTemp, Display, TEXT("ToolsPipeline: Resuming %s, %d entries already completed"), *Pipeline.Name, Completed.Num());
+    }
+    else
+    {
+        Journal.WriteLine(FString::Printf(TEXT("%s%08x"), JournalHeader, PipelineHash));
+        ResultLog.WriteLine(TEXT("Asset,Step,Result,Seconds,Detail"));
+    }
+
+    // The registry is filled asynchronously at startup, the filter needs all of it
+    FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+    AssetRegistryModule.Get().SearchAllAssets(true);
+
+    TArray<FAssetData> Assets = GatherAssets(Pipeline.Filter);
+    Assets.RemoveAll([&Completed](const FAssetData& Asset)
+    {
+        return Completed.Contains(Asset.PackageName.ToString());
+    });
+
+    TArray<const FToolsPipelineStep*> AssetSteps;
+    for (const FToolsPipelineStep& Step : Pipeline.Steps)
+    {
+        if (!IsGlobalStep(Step))
+        {
+            AssetSteps.Add(&Step);
+        }
+    }
+
+    int32 NumFailed = 0;
+    const int32 NumBatches = FMath::DivideAndRoundUp(Assets.Num(), Pipeline.BatchSize);
+    for (int32 BatchStart = 0; AssetSteps.Num() > 0 && BatchStart < Assets.Num(); BatchStart += Pipeline.BatchSize)
+    {
+        const int32 BatchEnd = FMath::Min(BatchStart + Pipeline.BatchSize, Assets.Num());
+        UE_LOG(LogTemp, Display, TEXT("ToolsPipeline: Batch %d/%d"), BatchStart / Pipeline.BatchSize + 1, NumBatches);
+
+        // Issue every load of the batch at once so the loader can overlap IO and serialization
+        TArray<UObject*> BatchAssets;
+        {
+            TOOLS_PHASE_SCOPE("Load", STAT_Tools_Load);
+            for (int32 Index = BatchStart; Index < BatchEnd; ++Index)
+            {
+                LoadPackageAsync(Assets[Index].PackageName.ToString());
+            }
+            FlushAsyncLoading();
+
+            for (int32 Index = BatchStart; Index < BatchEnd; ++Index)
+            {
+                BatchAssets.Add(Assets[Index].GetAsset());
+            }
+            FStaticMeshCompilingManager::Get().FinishAllCompilation();
+        }
+
+        TArray<bool> AssetFailed;
+        AssetFailed.SetNumZeroed(BatchAssets.Num());
+        for (int32 Index = 0; Index < BatchAssets.Num(); ++Index)
+        {
+            const FString PackageName = Assets[BatchStart + Index].PackageName.ToString();
+            UObject* Asset = BatchAssets[Index];
+
+            for (const FToolsPipelineStep* Step : AssetSteps)
+            {
+                FString Detail;
+                const double StartSeconds = FPlatformTime::Seconds();
+                const EStepResult Result = Asset ? RunAssetStep(*Step, Asset, Detail) : EStepResult::Failed;
+                if (!Asset)
+                {
+                    Detail = TEXT("Failed to load");
+                }
+
+                ResultLog.WriteLine(FString::Printf(TEXT("%s,%s,%s,%.3f,%s"), *PackageName, *Step->Operation, LexToString(Result),
+                    FPlatformTime::Seconds() - StartSeconds, *EscapeCsv(Detail)));
+
+                if (Result == EStepResult::Failed)
+                {
+                    AssetFailed[Index] = true;
+                    break;
+                }
+            }
+        }
+
+        // Journal a batch only once it is on disk, a crash before that replays the whole batch
+        {
+            TOOLS_PHASE_SCOPE("Save", STAT_Tools_Save);
+            FStaticMeshCompilingManager::Get().FinishAllCompilation();
+            for (int32 Index = 0; Pipeline.bSave && Index < BatchAssets.Num(); ++Index)
+            {
+                UObject* Asset = BatchAssets[Index];
+                if (!Asset || !Asset->GetPackage()->IsDirty())
+                {
+                    continue;
+                }
+
+                if (UEditorAssetLibrary::SaveLoadedAsset(Asset, true))
+                {
+                    FToolsOperationProfile::CountSaves(1);
+                }
+                else
+                {
+                    AssetFailed[Index] = true;
+                    UE_LOG(LogTemp, Warning, TEXT("ToolsPipeline: Failed to save %s"), *Asset->GetPathName());
+                }
+            }
+        }
+
+        FMeshToolsCache::Get().Save();
+        for (int32 Index = 0; Index < BatchAssets.Num(); ++Index)
+        {
+            NumFailed += AssetFailed[Index] ? 1 : 0;
+            Journal.WriteLine(FString::Printf(TEXT("%s\t%s"), *Assets[BatchStart + Index].PackageName.ToString(), AssetFailed[Index] ? TEXT("Failed") : TEXT("Done")));
+        }
+
+        TOOLS_PHASE_SCOPE("Garbage Collection", STAT_Tools_Load);
+        BatchAssets.Reset();
+        CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    }
+
+    // Project-wide steps run once, after every asset step is saved
+    for (int32 StepIndex = 0; StepIndex < Pipeline.Steps.Num(); ++StepIndex)
+    {
+        const FToolsPipelineStep& Step = Pipeline.Steps[StepIndex];
+        const FString StepKey = FString::Printf(TEXT("step:%d"), StepIndex);
+        if (!IsGlobalStep(Step) || Completed.Contains(StepKey))
+        {
+            continue;
+        }
+
+        const double StartSeconds = FPlatformTime::Seconds();
+        int32 NumMoveFailures = 0;
+        const FString Log = UAutoCleanupTool::MoveUnusedAssetsToFolder(Step.DestinationFolder, Step.ExcludedFolders, NumMoveFailures);
+        const bool bFailed = NumMoveFailures > 0 || !UEditorAssetLibrary::DoesDirectoryExist(Step.DestinationFolder);
+        UE_LOG(LogTemp, Display, TEXT("ToolsPipeline: %s"), *Log);
+
+        NumFailed += bFailed ? 1 : 0;
+        ResultLog.WriteLine(FString::Printf(TEXT("%s,%s,%s,%.3f,%s"), *Step.DestinationFolder, *Step.Operation, bFailed ? TEXT("Failed") : TEXT("Done"),
+            FPlatformTime::Seconds() - StartSeconds, *EscapeCsv(Log.Replace(LINE_TERMINATOR, TEXT(" ")).Replace(TEXT("\n"), TEXT(" ")))));
+        Journal.WriteLine(FString::Printf(TEXT("%s\t%s"), *StepKey, bFailed ? TEXT("Failed") : TEXT("Done")));
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("ToolsPipeline: %s finished, %d assets processed, %d failures, results in %s"), *Pipeline.Name, Assets.Num(), NumFailed, *ResultPath);
+    UE_LOG(LogTemp, Display, TEXT("ToolsPipeline: Mesh cache %d up to date, %d regenerated"), FMeshToolsCache::Get().GetNumHits(), FMeshToolsCache::Get().GetNumMisses());
+    UE_LOG(LogTemp, Display, TEXT("%s"), *ToolsOperationProfile.GetSummary());
+
+    return NumFailed > 0 ? 1 : 0;
+}
@@ -0,0 +1,206 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ToolsStats.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+
+DEFINE_STAT(STAT_Tools_RegistryQuery);
+DEFINE_STAT(STAT_Tools_Load);
+DEFINE_STAT(STAT_Tools_MeshBuild);
+DEFINE_STAT(STAT_Tools_TextureProcess);
+DEFINE_STAT(STAT_Tools_Save);
+DEFINE_STAT(STAT_Tools_Rename);
+DEFINE_STAT(STAT_Tools_Analysis);
+
+DEFINE_STAT(STAT_Tools_AssetsScanned);
+DEFINE_STAT(STAT_Tools_Builds);
+DEFINE_STAT(STAT_Tools_Saves);
+DEFINE_STAT(STAT_Tools_BytesTouched);
+
+namespace ToolsStatsPrivate
+{
+    /** Tool operations run on the game thread, so one active profile at a time */
+    FToolsOperationProfile* CurrentProfile = nullptr;
+
+    uint64 GetUsedPhysical()
+    {
+        return FPlatformMemory::GetStats().UsedPhysical;
+    }
+}
+
+FToolsOperationProfile::FToolsOperationProfile(const TCHAR* InOperationName)
+    : OperationName(InOperationName)
+{
+    if (!IsInGameThread())
+    {
+        return;
+    }
+
+    PreviousCurrent = ToolsStatsPrivate::CurrentProfile;
+    Outer = PreviousCurrent;
+
+    if (Outer)
+    {
+        Outer->BeginPhase(InOperationName);
+        return;
+    }
+
+    StartSeconds = FPlatformTime::Seconds();
+    StartUsedPhysicalBytes = ToolsStatsPrivate::GetUsedPhysical();
+    ToolsStatsPrivate::CurrentProfile = this;
+}
+
+FToolsOperationProfile::~FToolsOperationProfile()
+{
+    if (!IsInGameThread())
+    {
+        return;
+    }
+
+    if (Outer)
+    {
+        Outer->EndPhase();
+        return;
+    }
+
+    while (OpenPhases.Num() > 0)
+    {
+        EndPhase();
+    }
+
+    ToolsStatsPrivate::CurrentProfile = PreviousCurrent;
+    UE_LOG(LogTemp, Log, TEXT("%s"), *GetSummary());
+}
+
+void FToolsOperationProfile::BeginPhase(const TCHAR* PhaseName)
+{
+    if (Outer)
+    {
+        Outer->BeginPhase(PhaseName);
+        return;
+    }
+
+    int32 PhaseIndex = Phases.IndexOfByPredicate([PhaseName](const FPhase& Phase) { return Phase.Name == PhaseName; });
+    if (PhaseIndex == INDEX_NONE)
+    {
+        PhaseIndex = Phases.Num();
+        Phases.AddDefaulted_GetRef().Name = PhaseName;
+    }
+
+    FOpenPhase& Open = OpenPhases.AddDefaulted_GetRef();
+    Open.PhaseIndex = PhaseIndex;
+    Open.StartSeconds = FPlatformTime::Seconds();
+
+    // Reading process memory is too slow for phases that run once per asset
+    if (OpenPhases.Num() == 1)
+    {
+        Open.StartUsedPhysicalBytes = ToolsStatsPrivate::GetUsedPhysical();
+    }
+}
+
+void FToolsOperationProfile::EndPhase()
+{
+    if (Outer)
+    {
+        Outer->EndPhase();
+        return;
+    }
+
+    if (OpenPhases.Num() == 0)
+    {
+        return;
+    }
+
+    const FOpenPhase Open = OpenPhases.Pop(EAllowShrinking::No);
+    FPhase& Phase = Phases[Open.PhaseIndex];
+    ++Phase.Calls;
+    Phase.Seconds += FPlatformTime::Seconds() - Open.StartSeconds;
+
+    if (OpenPhases.Num() == 0)
+    {
+        const uint64 UsedPhysical = ToolsStatsPrivate::GetUsedPhysical();
+        Phase.MemoryDeltaBytes += int64(UsedPhysical) - int64(Open.StartUsedPhysicalBytes);
+        Phase.PeakUsedPhysicalBytes = FMath::Max(Phase.PeakUsedPhysicalBytes, UsedPhysical);
+    }
+}
+
+FToolsOperationProfile* FToolsOperationProfile::GetCurrent()
+{
+    return IsInGameThread() ? ToolsStatsPrivate::CurrentProfile : nullptr;
+}
+
+void FToolsOperationProfile::CountAssetsScanned(int32 Count)
+{
+    INC_DWORD_STAT_BY(STAT_Tools_AssetsScanned, Count);
+    if (FToolsOperationProfile* Profile = GetCurrent())
+    {
+        Profile->AssetsScanned += Count;
+    }
+}
+
+void FToolsOperationProfile::CountBuilds(int32 Count)
+{
+    INC_DWORD_STAT_BY(STAT_Tools_Builds, Count);
+    if (FToolsOperationProfile* Profile = GetCurrent())
+    {
+        Profile->Builds += Count;
+    }
+}
+
+void FToolsOperationProfile::CountSaves(int32 Count)
+{
+    INC_DWORD_STAT_BY(STAT_Tools_Saves, Count);
+    if (FToolsOperationProfile* Profile = GetCurrent())
+    {
+        Profile->Saves += Count;
+    }
+}
+
+void FToolsOperationProfile::CountBytesTouched(int64 Bytes)
+{
+    INC_MEMORY_STAT_BY(STAT_Tools_BytesTouched, Bytes);
+    if (FToolsOperationProfile* Profile = GetCurrent())
+    {
+        Profile->BytesTouched += Bytes;
+    }
+}
+
+FToolsPhaseScope::FToolsPhaseScope(const TCHAR* PhaseName)
+    : Profile(FToolsOperationProfile::GetCurrent())
+{
+    if (Profile)
+    {
+        Profile->BeginPhase(PhaseName);
+    }
+}
+
+FToolsPhaseScope::~FToolsPhaseScope()
+{
+    if (Profile)
+    {
+        Profile->EndPhase();
+    }
+}
+
+FString FToolsOperationProfile::GetSummary() const
+{
+    const double TotalSeconds = FMath::Max(FPlatformTime::Seconds() - StartSeconds, UE_SMALL_NUMBER);
+    const double ToMB = 1.0 / (1024.0 * 1024.0);
+
+    FString Summary = FString::Printf(TEXT("%s: %.3f s, memory %+.2f MB, %d assets scanned, %d builds, %d saves, %.2f MB touched\n"),
+        *OperationName, TotalSeconds, (int64(ToolsStatsPrivate::GetUsedPhysical()) - int64(StartUsedPhysicalBytes)) * ToMB,
+        AssetsScanned, Builds, Saves, BytesTouched * ToMB);
+
+    for (const FPhase& Phase : Phases)
+    {
+        Summary += FString::Printf(TEXT("  %-24s %6d calls %10.3f s (%5.1f%%)"), *Phase.Name, Phase.Calls, Phase.Seconds, 100.0 * Phase.Seconds / TotalSeconds);
+        if (Phase.PeakUsedPhysicalBytes > 0)
+        {
+            Summary += FString::Printf(TEXT(", memory %+.2f MB, peak %.2f MB"), Phase.MemoryDeltaBytes * ToMB, Phase.PeakUsedPhysicalBytes * ToMB);
+        }
+        Summary += TEXT("\n");
+    }
+
+    return Summary;
+}
@@ -2,4 +2,268 @@
 
 
 #include "USaveDataAsset.h"
+#include "Hash/CityHash.h"
 
+namespace SaveDataAssetPrivate
+{
+    uint32 HashUtf8(const ANSICHAR* Utf8, int32 Length)
+    {
+        return CityHash32(Utf8, Length);
+    }
+}
+
+int32 UUSaveDataAsset::GetNumStrings() const
+{
+    return bUseCompactStorage ? EntryOffsets.Num() : StringArray.Num();
+}
+
+FString UUSaveDataAsset::GetString(int32 Index) const
+{
+    if (bUseCompactStorage)
+    {
+        return EntryOffsets.IsValidIndex(Index)
+            ? FString(UTF8_TO_TCHAR(reinterpret_cast<const ANSICHAR*>(StringPool.GetData() + EntryOffsets[Index])))
+            : FString();
+    }
+
+    return StringArray.IsValidIndex(Index) ? StringArray[Index] : FString();
+}
+
+bool UUSaveDataAsset::ContainsString(const FString& Value) const
+{
+    return FindString(Value) != INDEX_NONE;
+}
+
+int32 UUSaveDataAsset::FindString(const FString& Value) const
+{
+    if (!bUseCompactStorage)
+    {
+        return StringArray.Find(Value);
+    }
+
+    const FTCHARToUTF8 Utf8(*Value);
+    return FindCompactString(Utf8.Get(), Utf8.Length(), SaveDataAssetPrivate::HashUtf8(Utf8.Get(), Utf8.Length()));
+}
+
+int32 UUSaveDataAsset::AddString(const FString& Value)
+{
+    return bUseCompactStorage ? AddCompactString(Value) : StringArray.Add(Value);
+}
+
+void UUSaveDataAsset::SetStrings(const TArray<FString>& Values)
+{
+    if (!bUseCompactStorage)
+    {
+        StringArray = Values;
+        return;
+    }
+
+    StringPool.Reset();
+    EntryOffsets.Reset(Values.Num());
+    HashTable.Reset();
+    NumIndexed = 0;
+
+    for (const FString& Value : Values)
+    {
+        AddCompactString(Value);
+    }
+
+    StringPool.Shrink();
+}
+
+TArray<FString> UUSaveDataAsset::GetAllStrings() const
+{
+    if (!bUseCompactStorage)
+    {
+        return StringArray;
+    }
+
+    TArray<FString> Values;
+    Values.Reserve(EntryOffsets.Num());
+    for (int32 Index = 0; Index < EntryOffsets.Num(); ++Index)
+    {
+        Values.Add(GetString(Index));
+    }
+    return Values;
+}
+
+void UUSaveDataAsset::SetUseCompactStorage(bool bCompact)
+{
+    if (bUseCompactStorage != bCompact)
+    {
+        Modify();
+        bUseCompactStorage = bCompact;
+        ConvertStorage();
+    }
+}
+
+void UUSaveDataAsset::PostLoad()
+{
+    Super::PostLoad();
+
+    if (bUseCompactStorage)
+    {
+        RebuildIndex();
+    }
+}
+
+void UUSaveDataAsset::PostDuplicate(bool bDuplicateForPIE)
+{
+    Super::PostDuplicate(bDuplicateForPIE);
+
+    // HashTable is not a property, the copy starts without it
+    if (bUseCompactStorage)
+    {
+        RebuildIndex();
+    }
+}
+
+#if WITH_EDITOR
+void UUSaveDataAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UUSaveDataAsset, bUseCompactStorage))
+    {
+        ConvertStorage();
+    }
+}
+
+void UUSaveDataAsset::PostEditUndo()
+{
+    Super::PostEditUndo();
+
+    // The transaction restores the pool and the offsets, not the index built over them
+    if (bUseCompactStorage)
+    {
+        RebuildIndex();
+    }
+    else
+    {
+        HashTable.Empty();
+        NumIndexed = 0;
+    }
+}
+#endif
+
+void UUSaveDataAsset::ConvertStorage()
+{
+    if (bUseCompactStorage)
+    {
+        // StringArray -> pool
+        TArray<FString> Values = MoveTemp(StringArray);
+        StringArray.Empty();
+        SetStrings(Values);
+    }
+    else
+    {
+        // Pool -> StringArray, read while the pool is still active
+        bUseCompactStorage = true;
+        TArray<FString> Values = GetAllStrings();
+        bUseCompactStorage = false;
+
+        StringArray = MoveTemp(Values);
+        StringPool.Empty();
+        EntryOffsets.Empty();
+        HashTable.Empty();
+        NumIndexed = 0;
+    }
+}
+
+int32 UUSaveDataAsset::AddCompactString(const FString& Value)
+{
+    const FTCHARToUTF8 Utf8(*Value);
+    const uint32 Hash = SaveDataAssetPrivate::HashUtf8(Utf8.Get(), Utf8.Length());
+
+    // Interned: an existing copy of the value is shared
+    const int32 ExistingEntry = FindCompactString(Utf8.Get(), Utf8.Length(), Hash);
+    if (ExistingEntry != INDEX_NONE)
+    {
+        return EntryOffsets.Add(EntryOffsets[ExistingEntry]);
+    }
+
+    const int32 Offset = StringPool.Num();
+    StringPool.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+    StringPool.Add(0);
+
+    const int32 EntryIndex = EntryOffsets.Add(Offset);
+    InsertInIndex(EntryIndex, Hash);
+    return EntryIndex;
+}
+
+int32 UUSaveDataAsset::FindCompactString(const ANSICHAR* Utf8, int32 Length, uint32 Hash) const
+{
+    if (HashTable.Num() == 0)
+    {
+        return INDEX_NONE;
+    }
+
+    const uint32 Mask = HashTable.Num() - 1;
+    for (uint32 Slot = Hash & Mask; ; Slot = (Slot + 1) & Mask)
+    {
+        const int32 EntryIndex = HashTable[Slot];
+        if (EntryIndex == INDEX_NONE)
+        {
+            return INDEX_NONE;
+        }
+
+        const int32 Offset = EntryOffsets[EntryIndex];
+        if (Offset + Length < StringPool.Num()
+            && StringPool[Offset + Length] == 0
+            && FMemory::Memcmp(StringPool.GetData() + Offset, Utf8, Length) == 0)
+        {
+            return EntryIndex;
+        }
+    }
+}
+
+void UUSaveDataAsset::RebuildIndex()
+{
+    HashTable.Reset();
+    NumIndexed = 0;
+
+    // Only the first entry of every interned offset is indexed
+    TSet<int32> IndexedOffsets;
+    for (int32 EntryIndex = 0; EntryIndex < EntryOffsets.Num(); ++EntryIndex)
+    {
+        const int32 Offset = EntryOffsets[EntryIndex];
+        bool bAlreadyIndexed = false;
+        IndexedOffsets.Add(Offset, &bAlreadyIndexed);
+        if (!bAlreadyIndexed)
+        {
+            const ANSICHAR* Utf8 = reinterpret_cast<const ANSICHAR*>(StringPool.GetData() + Offset);
+            InsertInIndex(EntryIndex, SaveDataAssetPrivate::HashUtf8(Utf8, FCStringAnsi::Strlen(Utf8)));
+        }
+    }
+}
+
+void UUSaveDataAsset::InsertInIndex(int32 EntryIndex, uint32 Hash)
+{
+    // Keep the load factor under one half so probe chains stay short
+    if ((NumIndexed + 1) * 2 > HashTable.Num())
+    {
+        const int32 NewSize = FMath::Max(16, int32(FMath::RoundUpToPowerOfTwo((NumIndexed + 1) * 4)));
+        const TArray<int32> OldTable = MoveTemp(HashTable);
+        HashTable.Init(INDEX_NONE, NewSize);
+        NumIndexed = 0;
+
+        for (const int32 OldEntry : OldTable)
+        {
+            if (OldEntry != INDEX_NONE)
+            {
+                const ANSICHAR* Utf8 = reinterpret_cast<const ANSICHAR*>(StringPool.GetData() + EntryOffsets[OldEntry]);
+                InsertInIndex(OldEntry, SaveDataAssetPrivate::HashUtf8(Utf8, FCStringAnsi::Strlen(Utf8)));
+            }
+        }
+    }
+
+    const uint32 Mask = HashTable.Num() - 1;
+    uint32 Slot = Hash & Mask;
+    while (HashTable[Slot] != INDEX_NONE)
+    {
+        Slot = (Slot + 1) & Mask;
+    }
+
+    HashTable[Slot] = EntryIndex;
+    ++NumIndexed;
+}
@@ -0,0 +1,192 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetFootprintAnalyzer.generated.h"
+
+/** Packages of one class within a hard-dependency closure */
+USTRUCT(BlueprintType)
+struct FAssetFootprintClassSize
+{
+    GENERATED_BODY()
+
+    /** Class of the main asset of the packages (e.g. Texture2D) */
+    UPROPERTY(BlueprintReadOnly, Category = "Asset Footprint")
+    FString ClassName;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Asset Footprint")
+    int32 NumPackages = 0;
+
+    /** Size of the packages on disk, from the registry */
+    UPROPERTY(BlueprintReadOnly, Category = "Asset Footprint")
+    int64 DiskBytes = 0;
+
+    /** Memory once loaded, estimated from the registry tags without loading anything */
+    UPROPERTY(BlueprintReadOnly, Category = "Asset Footprint")
+    int64 EstimatedMemoryBytes = 0;
+};
+
+/** One reference path from the root, with everything first reached through it */
+USTRUCT(BlueprintType)
+struct FAssetFootprintChain
+{
+    GENERATED_BODY()
+
+    /** Packages from the direct dependency of the root down to the heaviest package of the branch */
+    UPROPERTY(BlueprintReadOnly, Category = "Asset Footprint")
+    TArray<FString> Packages;
+
+    /** Packages pulled in through the first package of the chain */
+    UPROPERTY(BlueprintReadOnly, Category = "Asset Footprint")
+    int32 NumPackages = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Asset Footprint")
+    int64 DiskBytes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Asset Footprint")
+    int64 EstimatedMemoryBytes = 0;
+};
+
+/** Load footprint of one map or primary asset, produced by UAssetFootprintAnalyzer */
+USTRUCT(BlueprintType)
+struct FAssetFootprintReport
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Asset Footprint")
+    FString RootPackage;
+
+    /** "Map" or the primary asset type */
+    UPROPERTY(BlueprintReadOnly, Category = "Asset Footprint")
+    FString RootType;
+
+    /** Packages in the hard-dependency closure, the root included */
+    UPROPERTY(BlueprintReadOnly, Category = "Asset Footprint")
+    int32 NumPackages = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Asset Footprint")
+    int64 DiskBytes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Asset Footprint")
+    int64 EstimatedMemoryBytes = 0;
+
+    /** Sorted by estimated memory, largest first */
+    UPROPERTY(BlueprintReadOnly, Category = "Asset Footprint")
+    TArray<FAssetFootprintClassSize> ByClass;
+
+    /** Direct dependencies pulling in the most memory, largest first */
+    UPROPERTY(BlueprintReadOnly, Category = "Asset Footprint")
+    TArray<FAssetFootprintChain> HeaviestChains;
+};
+
+/** A hard object reference from an asset default to a heavy asset, candidate for a soft reference */
+USTRUCT(BlueprintType)
+struct FHardReferenceFinding
+{
+    GENERATED_BODY()
+
+    /** Blueprint or data asset holding the reference */
+    UPROPERTY(BlueprintReadOnly, Category = "Asset Footprint")
+    FString OwnerAsset;
+
+    /** Object holding the value: the class defaults or a component template of the Blueprint */
+    UPROPERTY(BlueprintReadOnly, Category = "Asset Footprint")
+    FString OwnerObject;
+
+    /** Class declaring the property, then the property and struct members (e.g. TP_WeaponComponent.FireSound) */
+    UPROPERTY(BlueprintReadOnly, Category = "Asset Footprint")
+    FString Property;
+
+    /** True for C++ properties, converted in code rather than in the Blueprint editor */
+    UPROPERTY(BlueprintReadOnly, Category = "Asset Footprint")
+    bool bNativeProperty = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Asset Footprint")
+    FString TargetAsset;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Asset Footprint")
+    FString TargetClass;
+
+    /** Estimated memory of the target and its own hard dependencies */
+    UPROPERTY(BlueprintReadOnly, Category = "Asset Footprint")
+    int64 TargetClosureBytes = 0;
+
+    /** Memory no longer loaded with the owner once this reference is soft */
+    UPROPERTY(BlueprintReadOnly, Category = "Asset Footprint")
+    int64 EstimatedSavingsBytes = 0;
+
+    /** Other hard references of the owner to the same package, all must be converted for the savings */
+    UPROPERTY(BlueprintReadOnly, Category = "Asset Footprint")
+    int32 OtherReferencesToTarget = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Asset Footprint")
+    FString Suggestion;
+};
+
+/**
+ * Measures what maps and primary assets cost to load by walking their hard-dependency closure
+ * in the Asset Registry graph. Nothing is loaded: disk sizes come from the package data and
+ * memory is estimated per class from the registry tags.
+ */
+UCLASS()
+class TOOLS_API UAssetFootprintAnalyzer : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+    /**
+    * Analyzes every map under /Game and every primary asset known to the Asset Manager.
+    * Roots are analyzed in parallel.
+    *
+    * @param MaxChains Number of heaviest dependency chains reported per root.
+    * @return One report per root, sorted by estimated memory (largest first).
+    */
+    UFUNCTION(CallInEditor, BlueprintCallable, Category = "Asset Footprint")
+    static TArray<FAssetFootprintReport> AnalyzeLoadFootprints(int32 MaxChains = 5);
+
+    /** Analyzes a single package (e.g. "/Game/Maps/Lvl_Main") */
+    UFUNCTION(CallInEditor, BlueprintCallable, Category = "Asset Footprint")
+    static FAssetFootprintReport AnalyzePackageFootprint(const FString& PackageName, int32 MaxChains = 5);
+
+    /**
+    * Writes reports to disk, as JSON if the file ends with ".json" and as CSV otherwise.
+    * The CSV has one Total row per root, then one row per class and per chain.
+    * @return true if the file was written.
+    */
+    UFUNCTION(CallInEditor, BlueprintCallable, Category = "Asset Footprint")
+    static bool ExportFootprintReports(const TArray<FAssetFootprintReport>& Reports, const FString& FilePath);
+
+    /**
+    * Finds hard object references in Blueprint class defaults, Blueprint component templates and
+    * data assets whose target weighs more than the threshold once its own dependencies are counted.
+    * Assets are loaded on the game thread in batches; the savings of each reference are computed in
+    * parallel on the registry graph, as the target closure minus what the owner still loads through
+    * its other dependencies.
+    *
+    * @param Folder         Folder scanned recursively (e.g. "/Game").
+    * @param MinTargetBytes Smallest estimated target closure reported.
+    * @return Findings sorted by estimated savings (largest first).
+    */
+    UFUNCTION(CallInEditor, BlueprintCallable, Category = "Asset Footprint")
+    static TArray<FHardReferenceFinding> AuditHardReferences(const FString& Folder = TEXT("/Game"), int64 MinTargetBytes = 1048576);
+
+    /**
+    * Writes findings to disk, as JSON if the file ends with ".json" and as CSV otherwise.
+    * @return true if the file was written.
+    */
+    UFUNCTION(CallInEditor, BlueprintCallable, Category = "Asset Footprint")
+    static bool ExportHardReferenceAudit(const TArray<FHardReferenceFinding>& Findings, const FString& FilePath);
+
+    /** Estimated memory of the package once loaded, from the tags of its main asset. Thread safe. */
+    static int64 EstimatePackageMemory(FName PackageName);
+
+    /**
+    * Collects the hard-dependency closure of a package, the package first, in breadth-first order.
+    * OutParents holds for each package the index of the package that first reached it (INDEX_NONE for the root).
+    * Native /Script packages are skipped. Thread safe.
+    */
+    static void CollectHardClosure(FName PackageName, TArray<FName>& OutPackages, TArray<int32>& OutParents);
+};
@@ -45,6 +45,17 @@ public:
     UFUNCTION(BlueprintCallable, Category = "AutoCleanup")
     static FString MoveUnusedAssetsToFolder(const FString& NewFolderPath, const TArray<FString>& ExcludedFolders);
 
+    /** Same as above, also returns the number of assets that could not be moved */
+    static FString MoveUnusedAssetsToFolder(const FString& NewFolderPath, const TArray<FString>& ExcludedFolders, int32& OutFailCount);
+
+    /**
+    * Same as MoveUnusedAssetsToFolder, but runs as a background job of the Tools job subsystem.
+    * Reference checks run on worker threads, renames are sliced on the game thread.
+    * @return Job id, or 0 if the job could not be submitted.
+    */
+    UFUNCTION(BlueprintCallable, Category = "AutoCleanup")
+    static int32 MoveUnusedAssetsToFolderAsync(const FString& NewFolderPath, const TArray<FString>& ExcludedFolders);
+
     /**
     * Returns an array of asset names that are currently unused in the project.
     */
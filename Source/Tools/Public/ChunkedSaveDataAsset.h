@@ -0,0 +1,106 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Serialization/BulkData.h"
+#include "ChunkedSaveDataAsset.generated.h"
+
+class UUSaveDataAsset;
+class IBulkDataIORequest;
+
+/**
+ * Paged variant of UUSaveDataAsset for very large string lists.
+ *
+ * Strings are split into fixed-size pages stored as out-of-line bulk data, so loading the asset
+ * only reads the page table. Pages are read on first access (or prefetched asynchronously) and
+ * the least recently used ones are evicted once the resident budget is exceeded.
+ * Meant to be used from the game thread.
+ */
+UCLASS()
+class TOOLS_API UChunkedSaveDataAsset : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+    /** Strings per page, applied by the next build */
+    UPROPERTY(EditAnywhere, Category = "Data", meta = (ClampMin = "16"))
+    int32 PageSize = 1024;
+
+    /** Budget in KB for resident pages and pending reads, least recently used pages are evicted above it (0 = unlimited) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Data", meta = (ClampMin = "0"))
+    int32 MaxResidentKB = 1024;
+
+    /** Number of strings */
+    UFUNCTION(BlueprintPure, Category = "Data")
+    int32 GetNumStrings() const { return NumStrings; }
+
+    /** String at Index, loading its page synchronously if needed. Empty if out of range. */
+    UFUNCTION(BlueprintCallable, Category = "Data")
+    FString GetString(int32 Index);
+
+    /** True if the page holding Index is in memory, completing its prefetch if the read has finished */
+    UFUNCTION(BlueprintCallable, Category = "Data")
+    bool IsStringResident(int32 Index);
+
+    /**
+    * Starts asynchronous reads of the pages covering the range. Their buffers count against the
+    * budget as soon as the reads are issued; pages that do not fit are left to be read on access.
+    */
+    UFUNCTION(BlueprintCallable, Category = "Data")
+    void PrefetchStrings(int32 FirstIndex, int32 Count);
+
+    /** Memory held by resident pages and pending reads */
+    UFUNCTION(BlueprintPure, Category = "Data")
+    int64 GetResidentBytes() const { return ResidentBytes; }
+
+    /** Rebuilds the pages from a list of strings */
+    UFUNCTION(BlueprintCallable, Category = "Data")
+    void BuildFromStrings(const TArray<FString>& Values);
+
+    /** Rebuilds the pages from the strings of a regular data asset */
+    UFUNCTION(BlueprintCallable, Category = "Data")
+    void BuildFromDataAsset(const UUSaveDataAsset* Source);
+
+    virtual void Serialize(FArchive& Ar) override;
+    virtual void BeginDestroy() override;
+
+private:
+    /**
+    * One page of strings. The payload is [int32 Count][int32 Offset x Count][UTF-8 null-terminated strings],
+    * offsets being relative to the start of the strings.
+    */
+    struct FPage
+    {
+        FByteBulkData BulkData;
+        TArray<uint8> Payload;
+        IBulkDataIORequest* PendingRequest = nullptr;
+        uint64 LastAccess = 0;
+        bool bResident = false;
+    };
+
+    /** Makes the page resident, waiting for its read if needed */
+    void LoadPage(int32 PageIndex);
+
+    /** Completes an asynchronous read if it has finished (or waits for it) */
+    bool CompletePendingRead(FPage& Page, bool bWait);
+
+    /** Completes the reads that have finished, without waiting for the others */
+    void PollPendingReads();
+
+    /**
+    * Evicts least recently used pages until the budget is met with IncomingBytes more, never the given page.
+    * @return false if pending reads and the pinned page alone exceed the budget.
+    */
+    bool EnforceBudget(int32 PinnedPage, int64 IncomingBytes = 0);
+
+    /** Cancels and releases every pending read */
+    void ReleasePendingReads();
+
+    TIndirectArray<FPage> Pages;
+    int32 NumStrings = 0;
+    int32 StringsPerPage = 0;
+    int64 ResidentBytes = 0;
+    uint64 AccessCounter = 0;
+};
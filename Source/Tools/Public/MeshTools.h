@@ -27,6 +27,267 @@
 
 class UBodySetup;
 
+/** Draw-call and memory comparison for one cell processed by UMeshTools::MergeLevelMeshesByCell */
+USTRUCT(BlueprintType)
+struct FMeshCellMergeReport
+{
+    GENERATED_BODY()
+
+    /** Grid coordinates of the cell (XY plane) */
+    UPROPERTY(BlueprintReadOnly, Category = "Mesh Tools")
+    FIntPoint Cell = FIntPoint::ZeroValue;
+
+    /** Number of static mesh actors merged into the cell mesh */
+    UPROPERTY(BlueprintReadOnly, Category = "Mesh Tools")
+    int32 SourceActorCount = 0;
+
+    /** Sum of LOD0 sections of the source components (one draw per section) */
+    UPROPERTY(BlueprintReadOnly, Category = "Mesh Tools")
+    int32 DrawCallsBefore = 0;
+
+    /** LOD0 sections of the merged mesh */
+    UPROPERTY(BlueprintReadOnly, Category = "Mesh Tools")
+    int32 DrawCallsAfter = 0;
+
+    /** Resource size of the unique source meshes used in the cell */
+    UPROPERTY(BlueprintReadOnly, Category = "Mesh Tools")
+    int64 MemoryBeforeBytes = 0;
+
+    /** Resource size of the merged mesh, LODs included */
+    UPROPERTY(BlueprintReadOnly, Category = "Mesh Tools")
+    int64 MemoryAfterBytes = 0;
+
+    /** Merged mesh asset created for the cell */
+    UPROPERTY(BlueprintReadOnly, Category = "Mesh Tools")
+    UStaticMesh* MergedMesh = nullptr;
+};
+
+/** Selection and conversion settings for UMeshTools::BatchEnableNanite */
+USTRUCT(BlueprintType)
+struct FNaniteBatchOptions
+{
+    GENERATED_BODY()
+
+    /** Folder scanned recursively for static meshes */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Nanite")
+    FString Folder = TEXT("/Game");
+
+    /** Meshes with fewer LOD0 triangles are left as they are */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Nanite")
+    int32 MinTriangleCount = 5000;
+
+    /** Accept meshes using masked materials in addition to opaque ones */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Nanite")
+    bool bAllowMaskedMaterials = true;
+
+    /** How the fallback mesh is reduced */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Nanite")
+    ENaniteFallbackTarget FallbackTarget = ENaniteFallbackTarget::Auto;
+
+    /** Fallback triangle percentage, used with ENaniteFallbackTarget::PercentTriangles */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Nanite", meta = (ClampMin = "0", ClampMax = "1"))
+    float FallbackPercentTriangles = 1.0f;
+
+    /** Fallback relative error, used with ENaniteFallbackTarget::RelativeError */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Nanite", meta = (ClampMin = "0"))
+    float FallbackRelativeError = 1.0f;
+
+    /** Remove hand-made LODs, Nanite streams its own clusters */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Nanite")
+    bool bClearHandMadeLODs = true;
+};
+
+/** Before/after figures for one mesh converted by UMeshTools::BatchEnableNanite */
+USTRUCT(BlueprintType)
+struct FNaniteMeshReport
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Nanite")
+    UStaticMesh* Mesh = nullptr;
+
+    /** LOD0 triangle count used for the selection */
+    UPROPERTY(BlueprintReadOnly, Category = "Nanite")
+    int32 Triangles = 0;
+
+    /** Number of hand-made LODs removed */
+    UPROPERTY(BlueprintReadOnly, Category = "Nanite")
+    int32 LODsRemoved = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Nanite")
+    int64 DiskBytesBefore = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Nanite")
+    int64 DiskBytesAfter = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Nanite")
+    int64 MemoryBytesBefore = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Nanite")
+    int64 MemoryBytesAfter = 0;
+};
+
+/** Result of the vertex precision check of one mesh by UMeshTools::ReduceVertexPrecision */
+USTRUCT(BlueprintType)
+struct FMeshPrecisionReport
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Mesh Tools")
+    UStaticMesh* Mesh = nullptr;
+
+    /** Largest UV error of 16-bit UVs, in texels of the reference texture size */
+    UPROPERTY(BlueprintReadOnly, Category = "Mesh Tools")
+    float MaxUVErrorTexels = 0.0f;
+
+    /** Largest angular error of 8-bit tangents, in degrees */
+    UPROPERTY(BlueprintReadOnly, Category = "Mesh Tools")
+    float MaxTangentErrorDegrees = 0.0f;
+
+    /** 16-bit UVs stay within the bound and were (or would be) applied */
+    UPROPERTY(BlueprintReadOnly, Category = "Mesh Tools")
+    bool bReducedUVs = false;
+
+    /** 8-bit tangents stay within the bound and were (or would be) applied */
+    UPROPERTY(BlueprintReadOnly, Category = "Mesh Tools")
+    bool bReducedTangents = false;
+
+    /** Vertex buffer memory saved over all LODs */
+    UPROPERTY(BlueprintReadOnly, Category = "Mesh Tools")
+    int64 BytesSaved = 0;
+};
+
+/** Material instances interchangeable with each other, found by UMeshTools::FindDuplicateMaterialInstances */
+USTRUCT(BlueprintType)
+struct FMaterialInstanceDuplicateGroup
+{
+    GENERATED_BODY()
+
+    /** Parent shared by every instance of the group */
+    UPROPERTY(BlueprintReadOnly, Category = "Materials")
+    FString Parent;
+
+    /** Resolved static switches, masks and overridden base properties, "Name=Value" joined by ';' */
+    UPROPERTY(BlueprintReadOnly, Category = "Materials")
+    FString StaticSignature;
+
+    /** Object paths of the instances, the first one (most referenced) is kept on consolidation */
+    UPROPERTY(BlueprintReadOnly, Category = "Materials")
+    TArray<FString> Instances;
+};
+
+/** Shader permutation estimate for the instances of one base material */
+USTRUCT(BlueprintType)
+struct FMaterialPermutationReport
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Materials")
+    FString BaseMaterial;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Materials")
+    int32 NumInstances = 0;
+
+    /** Instances overriding static parameters or base properties, each compiles its own shader map */
+    UPROPERTY(BlueprintReadOnly, Category = "Materials")
+    int32 NumStaticPermutationInstances = 0;
+
+    /** Distinct static signatures, the base material included */
+    UPROPERTY(BlueprintReadOnly, Category = "Materials")
+    int32 UniqueStaticPermutations = 0;
+
+    /** Static signatures used by a single instance, candidates to fold into a shared one */
+    UPROPERTY(BlueprintReadOnly, Category = "Materials")
+    int32 SingleUseStaticPermutations = 0;
+
+    /** Vertex factories compiled: the static mesh one plus one per usage flag of the base material */
+    UPROPERTY(BlueprintReadOnly, Category = "Materials")
+    int32 NumUsages = 0;
+
+    /** UniqueStaticPermutations x NumUsages, every pass shader is multiplied by it */
+    UPROPERTY(BlueprintReadOnly, Category = "Materials")
+    int32 EstimatedPermutations = 0;
+
+    /** Shader maps loaded with every instance: the base material plus the static permutation instances */
+    UPROPERTY(BlueprintReadOnly, Category = "Materials")
+    int32 EstimatedShaderMaps = 0;
+
+    /** Shader maps left once the duplicate groups are consolidated */
+    UPROPERTY(BlueprintReadOnly, Category = "Materials")
+    int32 EstimatedShaderMapsAfterConsolidation = 0;
+
+    /** Instances redundant with another one of the same group */
+    UPROPERTY(BlueprintReadOnly, Category = "Materials")
+    int32 DuplicateInstances = 0;
+};
+
+/** Density and fix-up settings for UMeshTools::AuditLightmapResolutions */
+USTRUCT(BlueprintType)
+struct FLightmapBatchOptions
+{
+    GENERATED_BODY()
+
+    /** Lightmap texels wanted per meter of world surface */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lightmaps", meta = (ClampMin = "0"))
+    float TexelsPerMeter = 32.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lightmaps", meta = (ClampMin = "4"))
+    int32 MinResolution = 16;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lightmaps", meta = (ClampMin = "4"))
+    int32 MaxResolution = 1024;
+
+    /** Generate lightmap UVs on meshes without a lightmap channel, with overlapping charts or below MinUVUtilization */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lightmaps")
+    bool bRegenerateLightmapUVs = false;
+
+    /** Share of the lightmap UV space covered by charts under which the UVs are regenerated */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lightmaps", meta = (ClampMin = "0", ClampMax = "1"))
+    float MinUVUtilization = 0.4f;
+
+    /** If false, only reports what would be changed */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lightmaps")
+    bool bApply = true;
+};
+
+/** Lightmap figures for one mesh processed by UMeshTools::AuditLightmapResolutions */
+USTRUCT(BlueprintType)
+struct FLightmapMeshReport
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Lightmaps")
+    UStaticMesh* Mesh = nullptr;
+
+    /** LOD0 surface in square meters, at the average scale of the placed instances */
+    UPROPERTY(BlueprintReadOnly, Category = "Lightmaps")
+    float SurfaceAreaMeters = 0.0f;
+
+    /** Share of the lightmap UV space covered by charts, above 1 when charts overlap */
+    UPROPERTY(BlueprintReadOnly, Category = "Lightmaps")
+    float UVUtilization = 0.0f;
+
+    /** Static mobility actors of the editor world using the mesh */
+    UPROPERTY(BlueprintReadOnly, Category = "Lightmaps")
+    int32 NumInstances = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Lightmaps")
+    int32 ResolutionBefore = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Lightmaps")
+    int32 ResolutionAfter = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Lightmaps")
+    bool bRegeneratedUVs = false;
+
+    /** Projected lightmap memory of the instances, one instance when the mesh is not placed */
+    UPROPERTY(BlueprintReadOnly, Category = "Lightmaps")
+    int64 MemoryBytesBefore = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Lightmaps")
+    int64 MemoryBytesAfter = 0;
+};
+
 UCLASS()
 class TOOLS_API UMeshTools : public UBlueprintFunctionLibrary
 {
@@ -52,6 +313,103 @@ public:
     UFUNCTION(CallInEditor, BlueprintCallable, Category = "Mesh Tools")
     static void GenerateSimpleCollision(UStaticMesh* Mesh);
 
+    /**
+    * GenerateLODsForMesh through FMeshToolsCache: skipped when the mesh already carries this LOD,
+    * built with the same values from the same source geometry. Otherwise the source models from
+    * LODIndex on are dropped and the LOD is generated again.
+    * @return true if the LOD was generated, false if it was up to date.
+    */
+    UFUNCTION(CallInEditor, BlueprintCallable, Category = "Mesh Tools")
+    static bool GenerateLODsForMeshIncremental(UStaticMesh* Mesh, int LODIndex, FVector2D LODsValues);
+
+    /**
+    * GenerateSimpleCollision through FMeshToolsCache: skipped when the mesh still carries the hull
+    * generated from the same source geometry and LOD setup.
+    * @return true if the collision was generated, false if it was up to date.
+    */
+    UFUNCTION(CallInEditor, BlueprintCallable, Category = "Mesh Tools")
+    static bool GenerateSimpleCollisionIncremental(UStaticMesh* Mesh);
+
+    /**
+    * Queues GenerateLODsForMesh on every mesh as a background job of UToolsJobSubsystem.
+    * One mesh is built per slice of the job frame budget, so the editor stays responsive.
+    * @return Id of the job, 0 if the job system is not available.
+    */
+    UFUNCTION(CallInEditor, BlueprintCallable, Category = "Mesh Tools")
+    static int32 GenerateLODsAsync(const TArray<UStaticMesh*>& Meshes, FVector2D LODsValues);
+
+    /**
+    * Queues GenerateSimpleCollision on every mesh as a background job of UToolsJobSubsystem.
+    * Positions are copied on the game thread, welded on worker threads, and the hulls are
+    * cooked one mesh per slice.
+    * @return Id of the job, 0 if the job system is not available.
+    */
+    UFUNCTION(CallInEditor, BlueprintCallable, Category = "Mesh Tools")
+    static int32 GenerateSimpleCollisionAsync(const TArray<UStaticMesh*>& Meshes);
+
+    /**
+    * Partitions the current editor level into a grid and merges the static meshes of each cell
+    * into one mesh with merged material slots, then generates its LODs through GenerateLODsForMesh.
+    *
+    * Only static mobility AStaticMeshActors are considered. Cell bucketing and cost analysis run
+    * in parallel; asset creation stays on the game thread.
+    *
+    * @param CellSize             Size of a grid cell in world units (XY plane).
+    * @param DestinationFolder    Folder receiving the merged meshes (must begin with /Game).
+    * @param LODsValues           LODs to add on each merged mesh (X -> triangle percent, Y -> screen size).
+    * @param MinActorsPerCell     Cells with fewer actors than this are left untouched.
+    * @param bReplaceSourceActors If true, spawns one actor per merged cell and removes the source actors.
+    * @return Draw-call and memory comparison for every merged cell.
+    */
+    UFUNCTION(CallInEditor, BlueprintCallable, Category = "Mesh Tools")
+    static TArray<FMeshCellMergeReport> MergeLevelMeshesByCell(float CellSize, const FString& DestinationFolder, const TArray<FVector2D>& LODsValues, int32 MinActorsPerCell = 2, bool bReplaceSourceActors = false);
+
+    /**
+    * Enables Nanite on every static mesh of a folder that passes the triangle-count and
+    * material blend mode checks, then rebuilds all of them with a single batched build.
+    *
+    * Triangle counts are read from the Asset Registry tags when available, so meshes below
+    * the threshold are never loaded. Converted meshes are saved.
+    *
+    * @param Options Selection, fallback and LOD clean-up settings.
+    * @return Disk and memory figures for every converted mesh.
+    */
+    UFUNCTION(CallInEditor, BlueprintCallable, Category = "Mesh Tools")
+    static TArray<FNaniteMeshReport> BatchEnableNanite(const FNaniteBatchOptions& Options);
+
+    /**
+    * Checks whether 16-bit UVs and 8-bit tangents keep each mesh within the given error bounds,
+    * measured on the mesh render data, and switches the build settings of the meshes that pass.
+    *
+    * The error of every LOD is measured in parallel. Meshes already using compact formats are skipped.
+    * Vertex positions are always stored at full precision by the static mesh vertex factory.
+    *
+    * @param Meshes                 Static meshes to process.
+    * @param MaxUVErrorTexels       Allowed UV error, in texels of ReferenceTextureSize.
+    * @param ReferenceTextureSize   Texture resolution used to express the UV error.
+    * @param MaxTangentErrorDegrees Allowed angular error of the tangent basis.
+    * @param bApply                 If false, only reports what would be changed.
+    * @return One report per processed mesh.
+    */
+    UFUNCTION(CallInEditor, BlueprintCallable, Category = "Mesh Tools")
+    static TArray<FMeshPrecisionReport> ReduceVertexPrecision(const TArray<UStaticMesh*>& Meshes, float MaxUVErrorTexels = 0.25f, int32 ReferenceTextureSize = 2048, float MaxTangentErrorDegrees = 1.0f, bool bApply = true);
+
+    /**
+    * Proposes a lightmap resolution for each mesh from its world surface and the share of the
+    * lightmap UV space its charts cover, so that every instance gets the target texel density.
+    *
+    * Surface and UV coverage are measured in parallel on the LOD0 render data; instance counts and
+    * scales come from the static actors of the editor world. Meshes with missing, overlapping or
+    * sparse lightmap UVs can get generated ones, rebuilt with a single batched build.
+    * Components overriding the lightmap resolution keep their override.
+    *
+    * @param Meshes  Static meshes to process.
+    * @param Options Target density, resolution bounds and UV regeneration settings.
+    * @return One report per processed mesh, with the projected lightmap memory before and after.
+    */
+    UFUNCTION(CallInEditor, BlueprintCallable, Category = "Mesh Tools")
+    static TArray<FLightmapMeshReport> AuditLightmapResolutions(const TArray<UStaticMesh*>& Meshes, const FLightmapBatchOptions& Options);
+
     /**
     * Replaces materials on a batch of static meshes.
     *
@@ -73,4 +431,50 @@ public:
     /** Returns all material asset data (for advanced use) */
     UFUNCTION(CallInEditor, BlueprintCallable, Category = "Materials")
     static TArray<FAssetData> GetAllMaterialAssets();
+
+    /**
+    * Groups the material instance constants of a folder by parent, static signature and resolved
+    * parameter values. Instances of a group render the same and can be consolidated.
+    *
+    * Instances are loaded on the game thread in batches. Instances parented to a duplicate only
+    * join its group once consolidated, run again after ConsolidateDuplicateMaterialInstances.
+    *
+    * @param Folder           Folder scanned recursively (e.g. "/Game").
+    * @param OutPermutations  Shader permutation estimate per base material, most permutations first.
+    * @return Groups of two instances or more, largest first.
+    */
+    UFUNCTION(CallInEditor, BlueprintCallable, Category = "Materials")
+    static TArray<FMaterialInstanceDuplicateGroup> FindDuplicateMaterialInstances(const FString& Folder, TArray<FMaterialPermutationReport>& OutPermutations);
+
+    /**
+    * Retargets the mesh slots and the editor world actors using a duplicate to the first instance of
+    * its group, as ReplaceMaterialBatch does, and reparents the instances derived from a duplicate.
+    * Duplicates still referenced by other assets (maps, Blueprints) are left in place.
+    *
+    * @param Groups            Groups from FindDuplicateMaterialInstances.
+    * @param bDeleteDuplicates Delete the duplicates once nothing references them.
+    * @return Number of duplicates no longer referenced.
+    */
+    UFUNCTION(CallInEditor, BlueprintCallable, Category = "Materials")
+    static int32 ConsolidateDuplicateMaterialInstances(const TArray<FMaterialInstanceDuplicateGroup>& Groups, bool bDeleteDuplicates = true);
+
+private:
+    /** Removes every source model but LOD0, without rebuilding. Returns the number of LODs removed. */
+    static int32 RemoveExtraSourceModels(UStaticMesh* Mesh);
+
+    /** Copies the vertex positions of the last LOD render data, the points of the simple collision hull */
+    static bool GatherCollisionPoints(const UStaticMesh* Mesh, TArray<FVector>& OutPoints);
+
+    /** Removes duplicate points, safe to call off the game thread */
+    static void WeldCollisionPoints(TArray<FVector>& Points);
+
+    /** Replaces the simple collision of the mesh by one convex hull of the points, then rebuilds */
+    static void ApplyCollisionPoints(UStaticMesh* Mesh, TArray<FVector>&& Points);
+
+    /**
+    * Swaps the slot materials found in Replacements on the meshes, then on the editor world actors
+    * using a modified mesh, and saves each modified mesh. A null key matches every other slot.
+    * @return Number of meshes modified.
+    */
+    static int32 ReplaceMaterialsOnMeshes(const TArray<UStaticMesh*>& Meshes, const TMap<UMaterialInterface*, UMaterialInterface*>& Replacements);
 };
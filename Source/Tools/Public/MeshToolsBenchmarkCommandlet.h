@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MeshToolsBenchmarkCommandlet.generated.h"
+
+class UStaticMesh;
+
+/** One UMeshTools operation measured on one synthetic mesh */
+USTRUCT(BlueprintType)
+struct FMeshToolsBenchmarkResult
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    FString Operation;
+
+    /** Triangles of the synthetic source mesh */
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    int32 Triangles = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    double Seconds = 0.0;
+
+    /** Highest used physical memory sampled during the operation, minus the amount used right before it */
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    double PeakMemoryMB = 0.0;
+
+    /** Name of the quality value: hull vertex count, LOD triangle ratio, ... */
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    FString QualityMetric;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    double Quality = 0.0;
+};
+
+/**
+ * Builds synthetic static meshes from 1k to 5M triangles, runs GenerateLODsForMesh,
+ * GenerateSimpleCollision, ClearLODs and ReplaceMaterialBatch on each, and compares wall time,
+ * peak memory and output quality against a stored baseline.
+ *
+ * Usage: UnrealEditor-Cmd Tools.uproject -run=MeshToolsBenchmark -nullrhi -unattended
+ *        [-Triangles=1000,10000,100000,1000000,5000000] [-Baseline=<file.json>] [-UpdateBaseline]
+ *        [-TimeTolerance=0.25] [-MemoryTolerance=0.25] [-QualityTolerance=0.1] [-Material=M_Red]
+ * The baseline defaults to Benchmarks/MeshToolsBaseline.json in the project folder and results go
+ * to Saved/Benchmarks/MeshTools.json. Returns 1 when any measurement regressed past its tolerance
+ * or when there is no baseline to compare against.
+ */
+UCLASS()
+class TOOLS_API UMeshToolsBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+    UMeshToolsBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+    /** Creates a displaced UV sphere of roughly the given triangle count, built and ready to edit */
+    static UStaticMesh* CreateSyntheticMesh(const FString& PackageName, int32 TargetTriangles);
+};
@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UStaticMesh;
+
+/**
+ * Persistent record of the mesh operations already applied, used to skip unchanged meshes
+ * when a folder is re-processed.
+ *
+ * Entries are keyed by a hash of the LOD0 source geometry, the operation and its parameters,
+ * and store a hash of the operation output. An operation is up to date when its key is known
+ * and the mesh still carries the recorded output, so a reimport, a parameter change or a manual
+ * edit of the result all cause the operation to run again.
+ * The cache lives in Saved/Tools/MeshToolsCache.bin and is written by Save() and at engine exit.
+ */
+class TOOLS_API FMeshToolsCache
+{
+public:
+    static FMeshToolsCache& Get();
+
+    /** Returned by MakeKey for meshes without geometry to identify, never up to date and never recorded */
+    static constexpr uint64 NoKey = 0;
+
+    /** Key of one operation with the given parameters on the current source geometry of the mesh */
+    static uint64 MakeKey(const UStaticMesh* Mesh, const TCHAR* Operation, const FString& Parameters);
+
+    /** True if the operation already ran on this geometry and left OutputHash on the mesh */
+    bool IsUpToDate(uint64 Key, uint64 OutputHash);
+
+    void Record(uint64 Key, uint64 OutputHash);
+
+    /** Writes the cache if it changed since the last save */
+    bool Save();
+
+    int32 GetNumHits() const { return NumHits; }
+    int32 GetNumMisses() const { return NumMisses; }
+
+private:
+    FMeshToolsCache();
+
+    void Load();
+
+    /** Hash of the LOD0 source geometry, changes whenever the mesh is reimported or edited. Empty without any geometry. */
+    static FString GetGeometryId(const UStaticMesh* Mesh);
+
+    FString FilePath;
+    TMap<uint64, uint64> Entries;
+    bool bDirty = false;
+    int32 NumHits = 0;
+    int32 NumMisses = 0;
+};
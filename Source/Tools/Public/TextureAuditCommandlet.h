@@ -0,0 +1,24 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TextureAuditCommandlet.generated.h"
+
+/**
+ * Runs UTextureTools::AuditTextureMemory headless and writes the report.
+ *
+ * Usage: UnrealEditor-Cmd Tools.uproject -run=TextureAudit [-Output=<file.csv|file.json>] [-MaxWorldSize=2048] [-MaxUISize=1024]
+ * The report goes to Saved/Audit/TextureAudit.csv by default.
+ */
+UCLASS()
+class TOOLS_API UTextureAuditCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+    UTextureAuditCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
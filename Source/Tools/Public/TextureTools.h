@@ -0,0 +1,176 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "Engine/Texture2D.h"
+#include "TextureTools.generated.h"
+
+/** Result of packing one Occlusion/Roughness/Metallic set with UTextureTools::PackORMTextures */
+USTRUCT(BlueprintType)
+struct FORMPackReport
+{
+    GENERATED_BODY()
+
+    /** Packed texture (R = Occlusion, G = Roughness, B = Metallic) */
+    UPROPERTY(BlueprintReadOnly, Category = "Texture Tools")
+    UTexture2D* PackedTexture = nullptr;
+
+    /** Grayscale textures the packed texture was built from */
+    UPROPERTY(BlueprintReadOnly, Category = "Texture Tools")
+    TArray<UTexture2D*> SourceTextures;
+
+    /** Material instances now sampling the packed texture */
+    UPROPERTY(BlueprintReadOnly, Category = "Texture Tools")
+    int32 MaterialInstancesRewired = 0;
+
+    /** Material instances whose parent has no ORM parameter, left untouched */
+    UPROPERTY(BlueprintReadOnly, Category = "Texture Tools")
+    int32 MaterialInstancesSkipped = 0;
+
+    /** Memory of the source textures, all mips */
+    UPROPERTY(BlueprintReadOnly, Category = "Texture Tools")
+    int64 SourceBytes = 0;
+
+    /** Memory of the packed texture, all mips */
+    UPROPERTY(BlueprintReadOnly, Category = "Texture Tools")
+    int64 PackedBytes = 0;
+};
+
+/** Memory figures and resize recommendation for one texture, produced by UTextureTools::AuditTextureMemory */
+USTRUCT(BlueprintType)
+struct FTextureAuditEntry
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Texture Tools")
+    FString AssetPath;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Texture Tools")
+    int32 Width = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Texture Tools")
+    int32 Height = 0;
+
+    /** Pixel format of the platform data (e.g. PF_DXT1) */
+    UPROPERTY(BlueprintReadOnly, Category = "Texture Tools")
+    FString Format;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Texture Tools")
+    int32 NumMips = 0;
+
+    /** In-memory size, all mips */
+    UPROPERTY(BlueprintReadOnly, Category = "Texture Tools")
+    int64 MemoryBytes = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Texture Tools")
+    FString LODGroup;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Texture Tools")
+    bool bNeverStream = false;
+
+    /** Mips can be streamed: not NeverStream, power of two and mipmapped */
+    UPROPERTY(BlueprintReadOnly, Category = "Texture Tools")
+    bool bStreamable = false;
+
+    /** Non power of two texture that cannot stream, always fully resident */
+    UPROPERTY(BlueprintReadOnly, Category = "Texture Tools")
+    bool bNonPowerOfTwo = false;
+
+    /** "UI", "World" or "Unused", from the referencing assets and the LOD group */
+    UPROPERTY(BlueprintReadOnly, Category = "Texture Tools")
+    FString Usage;
+
+    /** Materials referencing the texture */
+    UPROPERTY(BlueprintReadOnly, Category = "Texture Tools")
+    TArray<FString> Materials;
+
+    /** Recommended MaxTextureSize, 0 when the current size is fine */
+    UPROPERTY(BlueprintReadOnly, Category = "Texture Tools")
+    int32 SuggestedMaxSize = 0;
+
+    /** Memory saved by applying SuggestedMaxSize */
+    UPROPERTY(BlueprintReadOnly, Category = "Texture Tools")
+    int64 SuggestedSavingsBytes = 0;
+};
+
+/** Textures whose perceptual hashes are within the Hamming distance threshold of each other */
+USTRUCT(BlueprintType)
+struct FTextureDuplicateGroup
+{
+    GENERATED_BODY()
+
+    /** Object paths of the textures, the highest resolution first (kept by consolidation) */
+    UPROPERTY(BlueprintReadOnly, Category = "Texture Tools")
+    TArray<FString> AssetPaths;
+
+    /** Largest pHash or dHash Hamming distance between the first texture and the others */
+    UPROPERTY(BlueprintReadOnly, Category = "Texture Tools")
+    int32 MaxDistance = 0;
+};
+
+UCLASS()
+class TOOLS_API UTextureTools : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+    /**
+    * Finds separate Occlusion, Roughness and Metallic grayscale textures sharing a name
+    * (e.g. T_Wood_AO, T_Wood_Roughness, T_Wood_Metallic) and packs each set into one ORM texture.
+    *
+    * Sets are looked up in the folders UToolEditorSubsytem organizes imports into. Roughness plus
+    * at least one other map is required; a missing map is filled with its neutral value.
+    * The source textures are kept, UAutoCleanupTool can move them once unreferenced.
+    *
+    * @param Folder                   Folder scanned recursively (e.g. "/Game/Textures").
+    * @param ORMParameterName         Texture parameter of the parent material receiving the packed map.
+    * @param bRewireMaterialInstances If true, material instances using the separate maps are switched to the packed one.
+    * @return One report per packed set.
+    */
+    UFUNCTION(CallInEditor, BlueprintCallable, Category = "Texture Tools")
+    static TArray<FORMPackReport> PackORMTextures(const FString& Folder, FName ORMParameterName, bool bRewireMaterialInstances = true);
+
+    /**
+    * Scans every UTexture2D in /Game and reports its resolution, format, mips, memory, LOD group
+    * and streaming state, along with a max size recommendation based on how it is used.
+    *
+    * Textures are loaded on the game thread; usage classification and recommendations run in parallel.
+    *
+    * @param MaxWorldSize Largest size recommended for textures used in the world.
+    * @param MaxUISize    Largest size recommended for textures used by UI assets.
+    * @return One entry per texture, sorted by memory (largest first).
+    */
+    UFUNCTION(CallInEditor, BlueprintCallable, Category = "Texture Tools")
+    static TArray<FTextureAuditEntry> AuditTextureMemory(int32 MaxWorldSize = 2048, int32 MaxUISize = 1024);
+
+    /**
+    * Writes audit entries to disk, as JSON if the file ends with ".json" and as CSV otherwise.
+    * @return true if the file was written.
+    */
+    UFUNCTION(CallInEditor, BlueprintCallable, Category = "Texture Tools")
+    static bool ExportTextureAudit(const TArray<FTextureAuditEntry>& Entries, const FString& FilePath);
+
+    /**
+    * Finds textures that look the same through perceptual hashes (dHash and pHash) of their source mip.
+    *
+    * Source mips are read on the game thread in small batches; downsampling, hashing and the pairwise
+    * comparison run in parallel. Two textures match when both hashes are within the threshold and they
+    * share sRGB, compression settings and LOD group. Every texture of a group matches its first texture.
+    *
+    * @param Folder             Folder scanned recursively (e.g. "/Game").
+    * @param MaxHammingDistance Largest number of differing bits (out of 64) for two textures to match.
+    * @return Groups of near-duplicate textures.
+    */
+    UFUNCTION(CallInEditor, BlueprintCallable, Category = "Texture Tools")
+    static TArray<FTextureDuplicateGroup> FindDuplicateTextures(const FString& Folder, int32 MaxHammingDistance = 4);
+
+    /**
+    * Consolidates every group onto its first texture: references to the others are redirected to it
+    * and the duplicates are deleted.
+    * @return Number of textures removed.
+    */
+    UFUNCTION(CallInEditor, BlueprintCallable, Category = "Texture Tools")
+    static int32 ConsolidateDuplicateTextures(const TArray<FTextureDuplicateGroup>& Groups);
+};
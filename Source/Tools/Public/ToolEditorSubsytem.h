@@ -5,11 +5,18 @@
 #include "CoreMinimal.h"
 #include "EditorSubsystem.h"
 #include "Factories/Factory.h"
+#include "Containers/Ticker.h"
 #include "ToolEditorSubsytem.generated.h"
 
+struct FTextureImportRule;
+
 /**
  * Editor subsystem to handle automatic texture import organization.
  * Automatically places imported textures into a named folder under /Game/Textures/.
+ *
+ * Imported textures are queued and organized in one batch at the end of the frame,
+ * so bulk imports pay for a single rename and redirector fixup. The settings and destination
+ * of each texture come from the suffix rules of UToolTextureImportRules.
  */
 UCLASS()
 class TOOLS_API UToolEditorSubsytem : public UEditorSubsystem
@@ -21,11 +28,37 @@ public:
     virtual void Initialize(FSubsystemCollectionBase& Collection) override;
     virtual void Deinitialize() override;
 
+    /** Returns the name used to group a texture into its folder (e.g. "T_Wood_Albedo" -> "T") */
+    static FString GetTextureBaseName(const FString& TextureName);
+
+    /** Applies the compression, sRGB, group, size, mip and streaming settings of a rule */
+    static void ApplyImportRule(UTexture2D* Texture, const FTextureImportRule& Rule);
+
 private:
     // Callback for post asset import events
     void OnAssetPostImport(UFactory* InFactory, UObject* InObject);
 
-    // Internal utility to move texture asset to its dedicated folder
-    void OrganizeImportedTexture(UTexture2D* ImportedTexture);
-	
+    // Ticker callback flushing the queued imports once the import is over
+    bool OnFlushPendingImports(float DeltaTime);
+
+    // Callback keeping the folder cache in sync with deleted folders
+    void OnPathRemoved(const FString& Path);
+
+    // Moves a batch of textures to their dedicated folders with a single rename
+    void OrganizeImportedTextures(const TArray<UTexture2D*>& ImportedTextures);
+
+    // Creates the folder unless it is already known to exist
+    bool EnsureFolderExists(const FString& FolderPath);
+
+    /** Textures imported since the last flush */
+    TArray<TWeakObjectPtr<UTexture2D>> PendingTextures;
+
+    /** Folders known to exist, filled from the Asset Registry on first use */
+    TSet<FString> KnownFolders;
+
+    /** True once KnownFolders has been filled */
+    bool bKnownFoldersCached = false;
+
+    /** Pending end-of-frame flush, invalid when the queue is empty */
+    FTSTicker::FDelegateHandle FlushTickerHandle;
 };
@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "Engine/TextureDefines.h"
+#include "ToolTextureImportRules.generated.h"
+
+/**
+ * Settings applied to imported textures whose name ends with a given suffix.
+ * Every field of the matching rule is applied.
+ */
+USTRUCT()
+struct FTextureImportRule
+{
+    GENERATED_BODY()
+
+    /** Suffix matched case-insensitively at the end of the texture name (e.g. "_N", "_ORM") */
+    UPROPERTY(EditAnywhere, Category = "Rule")
+    FString Suffix;
+
+    /** Destination folder, "{Base}" is replaced by the texture base name. Empty or invalid keeps /Game/Textures/{Base} */
+    UPROPERTY(EditAnywhere, Category = "Rule")
+    FString DestinationFolder;
+
+    UPROPERTY(EditAnywhere, Category = "Rule")
+    TEnumAsByte<TextureCompressionSettings> CompressionSettings = TC_Default;
+
+    UPROPERTY(EditAnywhere, Category = "Rule")
+    bool bSRGB = true;
+
+    UPROPERTY(EditAnywhere, Category = "Rule")
+    TEnumAsByte<TextureGroup> LODGroup = TEXTUREGROUP_World;
+
+    /** Largest in-game resolution, 0 keeps the source resolution */
+    UPROPERTY(EditAnywhere, Category = "Rule", meta = (ClampMin = "0"))
+    int32 MaxTextureSize = 0;
+
+    UPROPERTY(EditAnywhere, Category = "Rule")
+    TEnumAsByte<TextureMipGenSettings> MipGenSettings = TMGS_FromTextureGroup;
+
+    UPROPERTY(EditAnywhere, Category = "Rule")
+    bool bVirtualTextureStreaming = false;
+};
+
+/**
+ * Suffix-driven rules used by UToolEditorSubsytem to set up imported textures.
+ * Stored in DefaultEditor.ini and editable in Project Settings > Editor > Texture Import Rules.
+ */
+UCLASS(config = Editor, defaultconfig, meta = (DisplayName = "Texture Import Rules"))
+class TOOLS_API UToolTextureImportRules : public UDeveloperSettings
+{
+    GENERATED_BODY()
+
+public:
+    UToolTextureImportRules();
+
+    /** Returns the rule with the longest suffix matching the texture name, nullptr if none matches */
+    const FTextureImportRule* FindRule(const FString& TextureName) const;
+
+    /** Disables the rules without losing them, textures are then only moved */
+    UPROPERTY(config, EditAnywhere, Category = "Import")
+    bool bApplyRules = true;
+
+    UPROPERTY(config, EditAnywhere, Category = "Import")
+    TArray<FTextureImportRule> Rules;
+};
@@ -0,0 +1,75 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/ARFilter.h"
+#include "Misc/ScopeRWLock.h"
+
+class IAssetRegistry;
+
+/**
+ * Asset Registry queries shared by every tool of the module.
+ *
+ * Results are kept until the registry reports an asset added, removed, renamed or updated, then
+ * everything is dropped at once. Asset lists are returned as shared immutable arrays, so repeated
+ * queries cost a map lookup and no copy. Reads are safe from worker threads; nothing is cached
+ * while the registry is still scanning.
+ * First use must happen on the game thread, UToolEditorSubsytem creates it at editor startup.
+ */
+class TOOLS_API FToolsAssetRegistryCache
+{
+public:
+    using FAssetList = TSharedRef<const TArray<FAssetData>, ESPMode::ThreadSafe>;
+
+    static FToolsAssetRegistryCache& Get();
+
+    /** IAssetRegistry::GetAssets, filters with tag/value pairs are not cached */
+    FAssetList GetAssets(const FARFilter& Filter);
+
+    FAssetList GetAssetsByPackageName(FName PackageName);
+
+    /** Invalid FAssetData if the object path is not in the registry */
+    FAssetData GetAssetByObjectPath(const FSoftObjectPath& ObjectPath);
+
+    /** Packages referencing the package, hard and soft, as IAssetRegistry::GetReferencers */
+    TArray<FName> GetReferencers(FName PackageName);
+
+    /** Packages the package needs loaded with it */
+    TArray<FName> GetHardDependencies(FName PackageName);
+
+    /** Size of the package file, 0 if the registry has no package data for it */
+    int64 GetPackageDiskSize(FName PackageName);
+
+    /** Drops every cached result */
+    void Invalidate();
+
+    static IAssetRegistry& GetRegistry();
+
+private:
+    FToolsAssetRegistryCache();
+
+    /** Registry events are unbound before exit, the registry module is gone by static destruction */
+    void UnbindRegistryEvents();
+
+    /** Runs Query outside the lock and stores its result unless the cache was invalidated meanwhile */
+    template<typename KeyType, typename ValueType, typename QueryType>
+    ValueType FindOrQuery(TMap<KeyType, ValueType>& Map, const KeyType& Key, QueryType&& Query);
+
+    static FString MakeFilterKey(const FARFilter& Filter);
+
+    FRWLock Lock;
+
+    /** Bumped by each invalidation */
+    uint32 Generation = 0;
+
+    TMap<FString, FAssetList> AssetsByFilter;
+    TMap<FName, FAssetList> AssetsByPackage;
+    TMap<FSoftObjectPath, FAssetData> AssetsByObjectPath;
+    TMap<FName, TArray<FName>> Referencers;
+    TMap<FName, TArray<FName>> HardDependencies;
+    TMap<FName, int64> PackageDiskSizes;
+
+    TArray<FDelegateHandle> RegistryHandles;
+};
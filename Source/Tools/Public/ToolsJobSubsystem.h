@@ -0,0 +1,207 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorSubsystem.h"
+#include "TickableEditorObject.h"
+#include "Tasks/Task.h"
+#include <atomic>
+#include "ToolsJobSubsystem.generated.h"
+
+class SDockTab;
+class FSpawnTabArgs;
+
+UENUM(BlueprintType)
+enum class EToolsJobState : uint8
+{
+    Pending,
+    Running,
+    Succeeded,
+    Failed,
+    Cancelled
+};
+
+/** State of one job, as shown in the job panel */
+USTRUCT(BlueprintType)
+struct FToolsJobRecord
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Tools Jobs")
+    int32 JobId = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Tools Jobs")
+    FString Name;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Tools Jobs")
+    EToolsJobState State = EToolsJobState::Pending;
+
+    /** Name of the phase running, or that ended the job */
+    UPROPERTY(BlueprintReadOnly, Category = "Tools Jobs")
+    FString Phase;
+
+    /** 0 to 1 over all phases */
+    UPROPERTY(BlueprintReadOnly, Category = "Tools Jobs")
+    float Progress = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Tools Jobs")
+    float Seconds = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Tools Jobs")
+    FString Error;
+};
+
+/** Handed to every phase of a job. Progress, cancellation and failure are safe from any thread. */
+class TOOLS_API FToolsJobContext
+{
+public:
+    /** Phases should check this between units of work and return early */
+    bool IsCancelled() const { return bCancelRequested.load(std::memory_order_relaxed); }
+
+    /** Progress of the current phase, 0 to 1 */
+    void SetProgress(float InProgress) { PhaseProgress.store(FMath::Clamp(InProgress, 0.0f, 1.0f), std::memory_order_relaxed); }
+
+    /** Stops the job after the current phase returns, dependent jobs are cancelled */
+    void Fail(const FString& Message);
+
+private:
+    friend class UToolsJobSubsystem;
+
+    std::atomic<bool> bCancelRequested { false };
+    std::atomic<bool> bFailed { false };
+    std::atomic<float> PhaseProgress { 0.0f };
+
+    mutable FCriticalSection ErrorLock;
+    FString Error;
+};
+
+/** One step of a job, run either on the task workers or in slices on the game thread */
+struct TOOLS_API FToolsJobPhase
+{
+    FString Name;
+
+    /** Runs once on a worker task. Must only read data the game thread will not change meanwhile. */
+    TFunction<void(FToolsJobContext&)> WorkerWork;
+
+    /** Called once per slice on the game thread until it returns true. Each call should be one short unit of work. */
+    TFunction<bool(FToolsJobContext&)> GameThreadStep;
+
+    static FToolsJobPhase Worker(const FString& InName, TFunction<void(FToolsJobContext&)> InWork);
+    static FToolsJobPhase GameThread(const FString& InName, TFunction<bool(FToolsJobContext&)> InStep);
+};
+
+/**
+ * Runs long tool operations as background jobs so the editor stays responsive.
+ *
+ * A job is a sequence of phases and may depend on other jobs. Worker phases run on the task
+ * system, which balances them (and any ParallelFor inside) across the worker threads. Game thread
+ * phases (builds, saves, renames) are stepped every frame within FrameBudgetMs. Jobs report
+ * progress, can be cancelled, and are listed in the Tools Jobs panel.
+ */
+UCLASS()
+class TOOLS_API UToolsJobSubsystem : public UEditorSubsystem, public FTickableEditorObject
+{
+	GENERATED_BODY()
+
+public:
+    // Subsystem lifecycle overrides
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    /** Returns the editor's job subsystem, null outside of the editor */
+    static UToolsJobSubsystem* Get();
+
+    /**
+     * Queues a job. It starts once every dependency has succeeded, and is cancelled if one of them
+     * fails, is cancelled or was never submitted. OnFinished is called on the game thread with the final state,
+     * from Tick once the job has left the active list, so it can submit follow-up jobs.
+     * @return Id of the job.
+     */
+    int32 SubmitJob(const FString& Name, TArray<FToolsJobPhase> Phases, const TArray<int32>& Dependencies = TArray<int32>(), TFunction<void(EToolsJobState)> OnFinished = nullptr);
+
+    /** Requests cancellation, the job stops at the next check of its current phase */
+    UFUNCTION(BlueprintCallable, Category = "Tools Jobs")
+    void CancelJob(int32 JobId);
+
+    UFUNCTION(BlueprintCallable, Category = "Tools Jobs")
+    void CancelAllJobs();
+
+    /** State of a queued, running or finished job */
+    UFUNCTION(BlueprintPure, Category = "Tools Jobs")
+    FToolsJobRecord GetJob(int32 JobId) const;
+
+    /** Active jobs first, then the history, most recent first */
+    UFUNCTION(BlueprintPure, Category = "Tools Jobs")
+    TArray<FToolsJobRecord> GetJobs() const;
+
+    UFUNCTION(BlueprintPure, Category = "Tools Jobs")
+    bool HasActiveJobs() const { return ActiveJobs.Num() > 0; }
+
+    /** Opens the job panel */
+    UFUNCTION(CallInEditor, BlueprintCallable, Category = "Tools Jobs")
+    static void OpenJobsPanel();
+
+    /** Game thread time given to game thread phases every frame */
+    UPROPERTY(EditAnywhere, Category = "Tools Jobs", meta = (ClampMin = "1"))
+    float FrameBudgetMs = 8.0f;
+
+    /** Finished jobs kept in the history */
+    UPROPERTY(EditAnywhere, Category = "Tools Jobs", meta = (ClampMin = "0"))
+    int32 MaxHistory = 100;
+
+    // FTickableEditorObject interface
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+    virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Always; }
+
+private:
+    struct FJob
+    {
+        int32 Id = 0;
+        FString Name;
+        TArray<FToolsJobPhase> Phases;
+        TArray<int32> Dependencies;
+        TFunction<void(EToolsJobState)> OnFinished;
+        TSharedRef<FToolsJobContext> Context = MakeShared<FToolsJobContext>();
+
+        EToolsJobState State = EToolsJobState::Pending;
+        int32 PhaseIndex = 0;
+        UE::Tasks::FTask WorkerTask;
+        bool bWorkerLaunched = false;
+        double StartSeconds = 0.0;
+    };
+
+    /** Starts pending jobs whose dependencies are done, cancels those whose dependencies did not succeed */
+    void StartReadyJobs();
+
+    /** Launches and collects worker phases */
+    void UpdateWorkerPhases();
+
+    /** Steps game thread phases round-robin until the frame budget is spent */
+    void RunGameThreadSlices();
+
+    /** Moves to the next phase, or finishes the job after the last one */
+    void AdvancePhase(FJob& Job);
+
+    void FinishJob(FJob& Job, EToolsJobState State);
+
+    EToolsJobState FindJobState(int32 JobId) const;
+
+    FToolsJobRecord MakeRecord(const FJob& Job) const;
+
+    TSharedRef<SDockTab> SpawnJobsTab(const FSpawnTabArgs& Args);
+
+    TArray<TSharedRef<FJob>> ActiveJobs;
+
+    /** Finished jobs, oldest first */
+    TArray<FToolsJobRecord> History;
+
+    /** Final state of every finished job, kept after its record leaves the history */
+    TMap<int32, EToolsJobState> FinishedStates;
+
+    int32 NextJobId = 1;
+
+    /** Job stepped first next frame, so one heavy job cannot starve the others */
+    int32 RoundRobinOffset = 0;
+};
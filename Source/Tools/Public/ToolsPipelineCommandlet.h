@@ -0,0 +1,106 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ToolsPipelineCommandlet.generated.h"
+
+/** Selects the assets a pipeline runs over */
+USTRUCT()
+struct FToolsPipelineFilter
+{
+    GENERATED_BODY()
+
+    /** Folders scanned recursively, must begin with /Game */
+    UPROPERTY()
+    TArray<FString> Paths;
+
+    /** Folders skipped even when inside one of the Paths */
+    UPROPERTY()
+    TArray<FString> ExcludedPaths;
+
+    /** Full class paths (e.g. /Script/Engine.StaticMesh), empty for every class */
+    UPROPERTY()
+    TArray<FString> ClassPaths;
+
+    /** Substring the asset name must contain, empty for every asset */
+    UPROPERTY()
+    FString NameContains;
+};
+
+/** One pipeline operation, mapped to an existing UMeshTools or UAutoCleanupTool call */
+USTRUCT()
+struct FToolsPipelineStep
+{
+    GENERATED_BODY()
+
+    /** GenerateLODs, ClearLODs, GenerateSimpleCollision, ReplaceMaterial or MoveUnusedAssets */
+    UPROPERTY()
+    FString Operation;
+
+    /** GenerateLODs: entry N is LOD N+1, X -> triangle percentage, Y -> screen size. Unchanged LODs are skipped */
+    UPROPERTY()
+    TArray<FVector2D> LODs;
+
+    /** ReplaceMaterial: material names under /Game, an empty MaterialToReplace replaces every slot */
+    UPROPERTY()
+    FString MaterialToReplace;
+
+    UPROPERTY()
+    FString NewMaterial;
+
+    /** MoveUnusedAssets: destination folder and folders left untouched */
+    UPROPERTY()
+    FString DestinationFolder;
+
+    UPROPERTY()
+    TArray<FString> ExcludedFolders;
+};
+
+/** Pipeline description loaded from JSON */
+USTRUCT()
+struct FToolsPipelineDesc
+{
+    GENERATED_BODY()
+
+    /** Names the journal and the result log, defaults to the file name */
+    UPROPERTY()
+    FString Name;
+
+    UPROPERTY()
+    FToolsPipelineFilter Filter;
+
+    /** Run in order on each asset; MoveUnusedAssets runs once, after every asset is processed */
+    UPROPERTY()
+    TArray<FToolsPipelineStep> Steps;
+
+    /** Assets loaded, processed and saved together before garbage collection */
+    UPROPERTY()
+    int32 BatchSize = 64;
+
+    UPROPERTY()
+    bool bSave = true;
+};
+
+/**
+ * Runs a JSON pipeline of UMeshTools and UAutoCleanupTool operations over a filtered set of assets.
+ *
+ * Usage: UnrealEditor-Cmd Tools.uproject -run=ToolsPipeline -Pipeline=<file.json> -unattended
+ *        [-BatchSize=64] [-Restart]
+ * Assets are loaded in batches with parallel async loads, processed, saved and garbage collected.
+ * Each saved batch is appended to Saved/Pipeline/<Name>.journal so an interrupted run resumes after
+ * the last saved batch and retries the entries that failed, unless -Restart is given or the pipeline
+ * file changed. Per-asset results are
+ * streamed to Saved/Pipeline/<Name>.csv. Returns 1 when the pipeline is invalid or any step failed.
+ */
+UCLASS()
+class TOOLS_API UToolsPipelineCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+    UToolsPipelineCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,104 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DECLARE_STATS_GROUP(TEXT("Tools"), STATGROUP_Tools, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Registry Queries"), STAT_Tools_RegistryQuery, STATGROUP_Tools, TOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Asset Loads"), STAT_Tools_Load, STATGROUP_Tools, TOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Mesh Builds"), STAT_Tools_MeshBuild, STATGROUP_Tools, TOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Texture Processing"), STAT_Tools_TextureProcess, STATGROUP_Tools, TOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Saves"), STAT_Tools_Save, STATGROUP_Tools, TOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Renames"), STAT_Tools_Rename, STATGROUP_Tools, TOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Analysis"), STAT_Tools_Analysis, STATGROUP_Tools, TOOLS_API);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Assets Scanned"), STAT_Tools_AssetsScanned, STATGROUP_Tools, TOOLS_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Builds"), STAT_Tools_Builds, STATGROUP_Tools, TOOLS_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Saves"), STAT_Tools_Saves, STATGROUP_Tools, TOOLS_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Bytes Touched"), STAT_Tools_BytesTouched, STATGROUP_Tools, TOOLS_API);
+
+/**
+ * Time and memory of every phase of one tool operation, logged as a summary when the profile goes
+ * out of scope so runs can be compared. Phases with the same name accumulate. A profile opened
+ * while another one is active becomes a phase of the outer one instead of logging on its own.
+ * Memory is sampled on top level phases only, nested phases report time.
+ */
+class TOOLS_API FToolsOperationProfile
+{
+public:
+    explicit FToolsOperationProfile(const TCHAR* InOperationName);
+    ~FToolsOperationProfile();
+
+    void BeginPhase(const TCHAR* PhaseName);
+    void EndPhase();
+
+    /** Counters, added to the Tools stat group and to the innermost active profile */
+    static void CountAssetsScanned(int32 Count);
+    static void CountBuilds(int32 Count);
+    static void CountSaves(int32 Count);
+    static void CountBytesTouched(int64 Bytes);
+
+    /** Active profile of the game thread, null outside of tool operations */
+    static FToolsOperationProfile* GetCurrent();
+
+    /** Multi-line summary of the phases and counters so far */
+    FString GetSummary() const;
+
+private:
+    struct FPhase
+    {
+        FString Name;
+        int32 Calls = 0;
+        double Seconds = 0.0;
+        int64 MemoryDeltaBytes = 0;
+        uint64 PeakUsedPhysicalBytes = 0;
+    };
+
+    struct FOpenPhase
+    {
+        int32 PhaseIndex = INDEX_NONE;
+        double StartSeconds = 0.0;
+        uint64 StartUsedPhysicalBytes = 0;
+    };
+
+    FString OperationName;
+    double StartSeconds = 0.0;
+    uint64 StartUsedPhysicalBytes = 0;
+
+    TArray<FPhase> Phases;
+    TArray<FOpenPhase> OpenPhases;
+
+    int32 AssetsScanned = 0;
+    int32 Builds = 0;
+    int32 Saves = 0;
+    int64 BytesTouched = 0;
+
+    /** Outer profile this one reports into as a phase */
+    FToolsOperationProfile* Outer = nullptr;
+    FToolsOperationProfile* PreviousCurrent = nullptr;
+};
+
+/** Opens a phase of the current profile for the enclosing scope */
+struct TOOLS_API FToolsPhaseScope
+{
+    explicit FToolsPhaseScope(const TCHAR* PhaseName);
+    ~FToolsPhaseScope();
+
+private:
+    FToolsOperationProfile* Profile;
+};
+
+/** Insights trace scope, stat cycle counter and profile phase for the enclosing scope */
+#define TOOLS_PHASE_SCOPE(PhaseName, Stat) \
+    TRACE_CPUPROFILER_EVENT_SCOPE_STR(PhaseName); \
+    SCOPE_CYCLE_COUNTER(Stat); \
+    FToolsPhaseScope ANONYMOUS_VARIABLE(ToolsPhaseScope)(TEXT(PhaseName))
+
+/** Insights trace scope and operation profile for a whole tool entry point */
+#define TOOLS_OPERATION_SCOPE(OperationName) \
+    TRACE_CPUPROFILER_EVENT_SCOPE_STR(OperationName); \
+    FToolsOperationProfile ToolsOperationProfile(TEXT(OperationName))
@@ -7,7 +7,11 @@
 #include "USaveDataAsset.generated.h"
 
 /**
- * 
+ * Data asset holding a list of strings.
+ *
+ * By default the strings live in StringArray. With bUseCompactStorage they are interned in a
+ * single UTF-8 pool with a hash index, for O(1) lookups and one allocation for the whole list.
+ * The accessors work in both modes.
  */
 UCLASS()
 class TOOLS_API UUSaveDataAsset : public UDataAsset
@@ -15,7 +19,81 @@ class TOOLS_API UUSaveDataAsset : public UDataAsset
 	GENERATED_BODY()
 	
 public:
-    // Editable array of strings accessible in Blueprint
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Data")
+    // Editable array of strings accessible in Blueprint, unused in compact storage where the accessors must be used
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Data", meta = (EditCondition = "!bUseCompactStorage", EditConditionHides))
     TArray<FString> StringArray;
+
+    /** Stores the strings in the interned pool instead of StringArray. Toggling it converts the data. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Data")
+    bool bUseCompactStorage = false;
+
+    /** Number of strings */
+    UFUNCTION(BlueprintPure, Category = "Data")
+    int32 GetNumStrings() const;
+
+    /** String at Index, empty if out of range */
+    UFUNCTION(BlueprintPure, Category = "Data")
+    FString GetString(int32 Index) const;
+
+    /** True if the value is in the list (hash lookup in compact mode) */
+    UFUNCTION(BlueprintPure, Category = "Data")
+    bool ContainsString(const FString& Value) const;
+
+    /** Index of the first occurrence of the value, INDEX_NONE if not found */
+    UFUNCTION(BlueprintPure, Category = "Data")
+    int32 FindString(const FString& Value) const;
+
+    /** Appends a value and returns its index */
+    UFUNCTION(BlueprintCallable, Category = "Data")
+    int32 AddString(const FString& Value);
+
+    /** Replaces the whole list */
+    UFUNCTION(BlueprintCallable, Category = "Data")
+    void SetStrings(const TArray<FString>& Values);
+
+    /** Copy of the whole list */
+    UFUNCTION(BlueprintPure, Category = "Data")
+    TArray<FString> GetAllStrings() const;
+
+    /** Switches between StringArray and the compact pool, moving the data */
+    UFUNCTION(BlueprintCallable, Category = "Data")
+    void SetUseCompactStorage(bool bCompact);
+
+    virtual void PostLoad() override;
+    virtual void PostDuplicate(bool bDuplicateForPIE) override;
+
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+    virtual void PostEditUndo() override;
+#endif
+
+private:
+    /** Moves the strings into the representation selected by bUseCompactStorage */
+    void ConvertStorage();
+
+    /** Appends a value to the pool (or reuses its interned copy) and returns its entry index */
+    int32 AddCompactString(const FString& Value);
+
+    /** Finds the entry index of a UTF-8 value in the hash index */
+    int32 FindCompactString(const ANSICHAR* Utf8, int32 Length, uint32 Hash) const;
+
+    /** Rebuilds HashTable from the pool */
+    void RebuildIndex();
+
+    /** Inserts an entry in HashTable, growing it when half full */
+    void InsertInIndex(int32 EntryIndex, uint32 Hash);
+
+    /** Unique strings, UTF-8 and null-terminated, back to back */
+    UPROPERTY()
+    TArray<uint8> StringPool;
+
+    /** Pool offset of every entry, equal strings share the same offset */
+    UPROPERTY()
+    TArray<int32> EntryOffsets;
+
+    /** Open-addressing table of entry indices (INDEX_NONE when empty), rebuilt after load, duplication and undo */
+    TArray<int32> HashTable;
+
+    /** Number of unique strings in HashTable */
+    int32 NumIndexed = 0;
 };
@@ -1,31 +1,73 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "TP_PickUpComponent.h"
+#include "ToolsPickUpSubsystem.h"
 
 UTP_PickUpComponent::UTP_PickUpComponent()
 {
 	// Setup the Sphere Collision
 	SphereRadius = 32.f;
+
+	bUseSpatialHash = false;
 }
 
 void UTP_PickUpComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
+	UToolsPickUpSubsystem* PickUpSubsystem = GetWorld()->GetSubsystem<UToolsPickUpSubsystem>();
+	if (bUseSpatialHash && PickUpSubsystem != nullptr)
+	{
+		// No physics involvement at all, the subsystem tests nearby characters
+		SetGenerateOverlapEvents(false);
+		SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		PickUpSubsystem->Register(this);
+		bWantsOnUpdateTransform = true;
+		return;
+	}
+
 	// Register our Overlap Event
 	OnComponentBeginOverlap.AddDynamic(this, &UTP_PickUpComponent::OnSphereBeginOverlap);
 }
 
+void UTP_PickUpComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UToolsPickUpSubsystem* PickUpSubsystem = GetWorld()->GetSubsystem<UToolsPickUpSubsystem>())
+	{
+		PickUpSubsystem->Unregister(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UTP_PickUpComponent::OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	Super::OnUpdateTransform(UpdateTransformFlags, Teleport);
+
+	if (bUseSpatialHash && HasBegunPlay())
+	{
+		if (UToolsPickUpSubsystem* PickUpSubsystem = GetWorld()->GetSubsystem<UToolsPickUpSubsystem>())
+		{
+			PickUpSubsystem->UpdateLocation(this);
+		}
+	}
+}
+
+void UTP_PickUpComponent::NotifyPickedUp(AToolsCharacter* Character)
+{
+	// Notify that the actor is being picked up
+	OnPickUp.Broadcast(Character);
+
+	// Unregister from the Overlap Event so it is no longer triggered
+	OnComponentBeginOverlap.RemoveAll(this);
+}
+
 void UTP_PickUpComponent::OnSphereBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
 	// Checking if it is a First Person Character overlapping
 	AToolsCharacter* Character = Cast<AToolsCharacter>(OtherActor);
 	if(Character != nullptr)
 	{
-		// Notify that the actor is being picked up
-		OnPickUp.Broadcast(Character);
-
-		// Unregister from the Overlap Event so it is no longer triggered
-		OnComponentBeginOverlap.RemoveAll(this);
+		NotifyPickedUp(Character);
 	}
 }
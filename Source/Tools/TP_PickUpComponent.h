@@ -22,12 +22,29 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Interaction")
 	FOnPickUp OnPickUp;
 
+	/**
+	 * Detect characters through UToolsPickUpSubsystem's spatial hash instead of physics overlaps.
+	 * Overlap events and collision are disabled on the sphere entirely. Moving pickups are re-hashed
+	 * whenever their transform changes.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Interaction")
+	bool bUseSpatialHash;
+
 	UTP_PickUpComponent();
+
+	/** Fires OnPickUp for the character and stops listening for further pickups */
+	void NotifyPickedUp(AToolsCharacter* Character);
 protected:
 
 	/** Called when the game starts */
 	virtual void BeginPlay() override;
 
+	/** Called when the game ends or the component is destroyed */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Keeps the spatial hash cell in sync when the pickup moves */
+	virtual void OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport) override;
+
 	/** Code for when something overlaps this component */
 	UFUNCTION()
 	void OnSphereBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
@@ -4,6 +4,8 @@
 #include "TP_WeaponComponent.h"
 #include "ToolsCharacter.h"
 #include "ToolsProjectile.h"
+#include "ToolsProjectilePool.h"
+#include "ToolsProjectileManager.h"
 #include "GameFramework/PlayerController.h"
 #include "Camera/PlayerCameraManager.h"
 #include "Kismet/GameplayStatics.h"
@@ -18,6 +20,18 @@ UTP_WeaponComponent::UTP_WeaponComponent()
 {
 	// Default offset from the character location for projectiles to spawn
 	MuzzleOffset = FVector(100.0f, 0.0f, 10.0f);
+
+	// Enough projectiles for three seconds of sustained fire before the pool has to grow
+	ProjectilePoolSize = 32;
+
+	bUseProjectileManager = false;
+	ManagedProjectileMesh = nullptr;
+
+	ReplicationMode = EToolsWeaponReplication::None;
+	SpreadDegrees = 0.0f;
+
+	// Needed for the fire RPCs
+	SetIsReplicatedByDefault(true);
 }
 
 
@@ -39,12 +53,25 @@ void UTP_WeaponComponent::Fire()
 			// MuzzleOffset is in camera space, so transform it to world space before offsetting from the character location to find the final muzzle position
 			const FVector SpawnLocation = GetOwner()->GetActorLocation() + SpawnRotation.RotateVector(MuzzleOffset);
 	
-			//Set Spawn Collision Handling Override
-			FActorSpawnParameters ActorSpawnParams;
-			ActorSpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButDontSpawnIfColliding;
-	
-			// Spawn the projectile at the muzzle
-			World->SpawnActor<AToolsProjectile>(ProjectileClass, SpawnLocation, SpawnRotation, ActorSpawnParams);
+			const FToolsQuantizedShot Shot = FToolsQuantizedShot::Make(SpawnLocation, SpawnRotation, uint16(FMath::Rand()));
+
+			if (ReplicationMode == EToolsWeaponReplication::None)
+			{
+				SpawnShot(Shot, false);
+			}
+			else if (GetOwner()->HasAuthority())
+			{
+				HandleServerShot(Shot);
+			}
+			else
+			{
+				// Predict the shot locally, the server owns the hits
+				if (ReplicationMode == EToolsWeaponReplication::FireEvent)
+				{
+					SpawnShot(Shot, true);
+				}
+				ServerFire(Shot);
+			}
 		}
 	}
 	
@@ -66,6 +93,78 @@ void UTP_WeaponComponent::Fire()
 	}
 }
 
+void UTP_WeaponComponent::ServerFire_Implementation(const FToolsQuantizedShot& Shot)
+{
+	HandleServerShot(Shot);
+}
+
+void UTP_WeaponComponent::MulticastFire_Implementation(const FToolsQuantizedShot& Shot)
+{
+	// The server simulated it already and the owning client predicted it
+	if (GetOwner()->HasAuthority() || (Character != nullptr && Character->IsLocallyControlled()))
+	{
+		return;
+	}
+
+	SpawnShot(Shot, true);
+}
+
+void UTP_WeaponComponent::SpawnShot(const FToolsQuantizedShot& Shot, bool bCosmetic)
+{
+	UWorld* const World = GetWorld();
+	if (World == nullptr || ProjectileClass == nullptr)
+	{
+		return;
+	}
+
+	const FVector SpawnLocation = Shot.GetOrigin();
+	const FRotator SpawnRotation = Shot.GetRotation(SpreadDegrees);
+
+	// Same simulation path on the server and the clients replaying the shot, only the hit authority differs
+	if (bUseProjectileManager)
+	{
+		// Simulated with every other managed projectile, no actor involved
+		World->GetSubsystem<UToolsProjectileManager>()->SpawnProjectile(ProjectileClass, ManagedProjectileMesh, SpawnLocation, SpawnRotation, bCosmetic);
+	}
+	else
+	{
+		// Take a projectile from the pool at the muzzle, spawning one if the pool is empty
+		World->GetSubsystem<UToolsProjectilePool>()->Acquire(ProjectileClass, SpawnLocation, SpawnRotation, bCosmetic);
+	}
+}
+
+void UTP_WeaponComponent::HandleServerShot(const FToolsQuantizedShot& Shot)
+{
+	// Refuse shots fired far away from the weapon holder
+	if (Character == nullptr || FVector::DistSquared(Shot.GetOrigin(), Character->GetActorLocation()) > FMath::Square(2.0f * MuzzleOffset.Size() + 100.0f))
+	{
+		return;
+	}
+
+	UWorld* const World = GetWorld();
+	if (ReplicationMode == EToolsWeaponReplication::ActorReplication)
+	{
+		// Naive path, kept to compare against fire events
+		FActorSpawnParameters ActorSpawnParams;
+		ActorSpawnParams.Owner = Character;
+		ActorSpawnParams.Instigator = Character;
+		ActorSpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButDontSpawnIfColliding;
+
+		if (AToolsProjectile* Projectile = World->SpawnActor<AToolsProjectile>(ProjectileClass, Shot.GetOrigin(), Shot.GetRotation(SpreadDegrees), ActorSpawnParams))
+		{
+			Projectile->SetReplicates(true);
+			Projectile->SetReplicateMovement(true);
+		}
+	}
+	else
+	{
+		SpawnShot(Shot, false);
+		MulticastFire(Shot);
+	}
+
+	FToolsNetShotStats::RecordShot(World, ReplicationMode);
+}
+
 bool UTP_WeaponComponent::AttachWeapon(AToolsCharacter* TargetCharacter)
 {
 	Character = TargetCharacter;
@@ -83,6 +182,19 @@ bool UTP_WeaponComponent::AttachWeapon(AToolsCharacter* TargetCharacter)
 	// add the weapon as an instance component to the character
 	Character->AddInstanceComponent(this);
 
+	// Fire RPCs go through the holder's connection
+	if (ReplicationMode != EToolsWeaponReplication::None && GetOwner()->HasAuthority())
+	{
+		GetOwner()->SetReplicates(true);
+		GetOwner()->SetOwner(Character);
+	}
+
+	// Spawn the projectiles up front so firing does not create actors
+	if (ProjectileClass != nullptr && GetWorld() != nullptr && !bUseProjectileManager)
+	{
+		GetWorld()->GetSubsystem<UToolsProjectilePool>()->Prewarm(ProjectileClass, ProjectilePoolSize);
+	}
+
 	// Set up action bindings
 	if (APlayerController* PlayerController = Cast<APlayerController>(Character->GetController()))
 	{
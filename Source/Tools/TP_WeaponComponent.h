@@ -4,9 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "ToolsQuantizedShot.h"
 #include "TP_WeaponComponent.generated.h"
 
 class AToolsCharacter;
+class UStaticMesh;
 
 UCLASS(Blueprintable, BlueprintType, ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class TOOLS_API UTP_WeaponComponent : public USkeletalMeshComponent
@@ -18,6 +20,26 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category=Projectile)
 	TSubclassOf<class AToolsProjectile> ProjectileClass;
 
+	/** Projectiles spawned ahead of time when the weapon is attached, reused shot after shot */
+	UPROPERTY(EditDefaultsOnly, Category=Projectile, meta=(ClampMin="0"))
+	int32 ProjectilePoolSize;
+
+	/** Fire lightweight projectiles simulated in batch by UToolsProjectileManager instead of projectile actors, on every machine */
+	UPROPERTY(EditDefaultsOnly, Category=Projectile)
+	bool bUseProjectileManager;
+
+	/** Mesh drawn for managed projectiles (instanced), none draws nothing */
+	UPROPERTY(EditDefaultsOnly, Category=Projectile)
+	UStaticMesh* ManagedProjectileMesh;
+
+	/** How shots are sent to the other machines in a network game */
+	UPROPERTY(EditDefaultsOnly, Category=Replication)
+	EToolsWeaponReplication ReplicationMode;
+
+	/** Random spread of shots, replayed from the shot seed on every machine */
+	UPROPERTY(EditDefaultsOnly, Category=Projectile, meta=(ClampMin="0", Units="Degrees"))
+	float SpreadDegrees;
+
 	/** Sound to play each time we fire */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Gameplay)
 	USoundBase* FireSound;
@@ -54,6 +76,20 @@ protected:
 	UFUNCTION()
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
+	/** Sends a shot fired by the owning client to the server */
+	UFUNCTION(Server, Reliable)
+	void ServerFire(const FToolsQuantizedShot& Shot);
+
+	/** Replays a shot on every client, in FireEvent mode */
+	UFUNCTION(NetMulticast, Unreliable)
+	void MulticastFire(const FToolsQuantizedShot& Shot);
+
+	/** Spawns the shot's projectile on this machine, cosmetic ones leave physics hits to the server */
+	void SpawnShot(const FToolsQuantizedShot& Shot, bool bCosmetic);
+
+	/** Server side of a shot: authoritative projectile, then relays it in the replication mode */
+	void HandleServerShot(const FToolsQuantizedShot& Shot);
+
 private:
 	/** The Character holding this weapon*/
 	AToolsCharacter* Character;
@@ -16,9 +16,17 @@ public class Tools : ModuleRules
 			"EnhancedInput",
             "MeshReductionInterface",
 			"StaticMeshDescription",
+			"MeshDescription",
 			"AssetRegistry",
 			"AssetTools",
+			"DeveloperSettings",
+			"Json",
+			"JsonUtilities",
+			"MeshMergeUtilities",
 			"EditorSubsystem",
+			"Slate",
+			"SlateCore",
+			"WorkspaceMenuStructure",
 			"UnrealEd",
             "EditorScriptingUtilities",
             "Blutility"
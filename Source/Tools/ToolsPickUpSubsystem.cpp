@@ -0,0 +1,182 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ToolsPickUpSubsystem.h"
+#include "TP_PickUpComponent.h"
+#include "ToolsCharacter.h"
+#include "Components/CapsuleComponent.h"
+#include "EngineUtils.h"
+
+void UToolsPickUpSubsystem::Register(UTP_PickUpComponent* PickUp)
+{
+	if (PickUp == nullptr || PickUpCells.Contains(PickUp))
+	{
+		return;
+	}
+
+	const FIntVector Cell = GetCell(PickUp->GetComponentLocation());
+	Cells.FindOrAdd(Cell).PickUps.Add(PickUp);
+	PickUpCells.Add(PickUp, Cell);
+
+	MaxPickUpRadius = FMath::Max(MaxPickUpRadius, PickUp->GetScaledSphereRadius());
+}
+
+void UToolsPickUpSubsystem::Unregister(UTP_PickUpComponent* PickUp)
+{
+	FIntVector Cell;
+	if (!PickUpCells.RemoveAndCopyValue(PickUp, Cell))
+	{
+		return;
+	}
+
+	if (FToolsPickUpCell* CellPickUps = Cells.Find(Cell))
+	{
+		CellPickUps->PickUps.RemoveSwap(PickUp);
+		if (CellPickUps->PickUps.Num() == 0)
+		{
+			Cells.Remove(Cell);
+		}
+	}
+}
+
+void UToolsPickUpSubsystem::UpdateLocation(UTP_PickUpComponent* PickUp)
+{
+	FIntVector* OldCell = PickUpCells.Find(PickUp);
+	if (OldCell == nullptr)
+	{
+		return;
+	}
+
+	const FIntVector NewCell = GetCell(PickUp->GetComponentLocation());
+	if (NewCell == *OldCell)
+	{
+		return;
+	}
+
+	if (FToolsPickUpCell* CellPickUps = Cells.Find(*OldCell))
+	{
+		CellPickUps->PickUps.RemoveSwap(PickUp);
+		if (CellPickUps->PickUps.Num() == 0)
+		{
+			Cells.Remove(*OldCell);
+		}
+	}
+
+	Cells.FindOrAdd(NewCell).PickUps.Add(PickUp);
+	*OldCell = NewCell;
+}
+
+TStatId UToolsPickUpSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UToolsPickUpSubsystem, STATGROUP_Tickables);
+}
+
+void UToolsPickUpSubsystem::Deinitialize()
+{
+	Cells.Empty();
+	PickUpCells.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UToolsPickUpSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+FIntVector UToolsPickUpSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt(Location.X / CellSize),
+		FMath::FloorToInt(Location.Y / CellSize),
+		FMath::FloorToInt(Location.Z / CellSize));
+}
+
+void UToolsPickUpSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Cells.Num() == 0)
+	{
+		return;
+	}
+
+	// Collect first, OnPickUp handlers attach or destroy pickups and would change the hash under us
+	TArray<TPair<TWeakObjectPtr<UTP_PickUpComponent>, TWeakObjectPtr<AToolsCharacter>>> Touches;
+
+	for (TActorIterator<AToolsCharacter> It(GetWorld()); It; ++It)
+	{
+		AToolsCharacter* Character = *It;
+		const UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+		const FVector Center = Capsule->GetComponentLocation();
+		const float Radius = Capsule->GetScaledCapsuleRadius();
+		const float HalfSegment = Capsule->GetScaledCapsuleHalfHeight_WithoutHemisphere();
+
+		// Every cell a touching pickup center can be in
+		const FVector Reach(Radius + MaxPickUpRadius, Radius + MaxPickUpRadius, HalfSegment + Radius + MaxPickUpRadius);
+		const FIntVector MinCell = GetCell(Center - Reach);
+		const FIntVector MaxCell = GetCell(Center + Reach);
+
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+			{
+				for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+				{
+					const FToolsPickUpCell* Cell = Cells.Find(FIntVector(X, Y, Z));
+					if (Cell == nullptr)
+					{
+						continue;
+					}
+
+					for (const TWeakObjectPtr<UTP_PickUpComponent>& WeakPickUp : Cell->PickUps)
+					{
+						const UTP_PickUpComponent* PickUp = WeakPickUp.Get();
+						if (PickUp == nullptr)
+						{
+							continue;
+						}
+
+						// Sphere against the capsule's inner segment
+						const FVector PickUpLocation = PickUp->GetComponentLocation();
+						const FVector Closest(Center.X, Center.Y, FMath::Clamp(PickUpLocation.Z, Center.Z - HalfSegment, Center.Z + HalfSegment));
+						const float TouchDistance = Radius + PickUp->GetScaledSphereRadius();
+						if (FVector::DistSquared(Closest, PickUpLocation) <= FMath::Square(TouchDistance))
+						{
+							Touches.Emplace(WeakPickUp, Character);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	for (const TPair<TWeakObjectPtr<UTP_PickUpComponent>, TWeakObjectPtr<AToolsCharacter>>& Touch : Touches)
+	{
+		UTP_PickUpComponent* PickUp = Touch.Key.Get();
+		AToolsCharacter* Character = Touch.Value.Get();
+
+		// A pickup touched by two characters goes to the first one only
+		if (PickUp != nullptr && Character != nullptr && PickUpCells.Contains(PickUp))
+		{
+			Unregister(PickUp);
+			PickUp->NotifyPickedUp(Character);
+		}
+	}
+
+	// Drop pickups destroyed without unregistering
+	for (auto It = PickUpCells.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			if (FToolsPickUpCell* Cell = Cells.Find(It.Value()))
+			{
+				Cell->PickUps.RemoveAllSwap([](const TWeakObjectPtr<UTP_PickUpComponent>& PickUp) { return !PickUp.IsValid(); });
+				if (Cell->PickUps.Num() == 0)
+				{
+					Cells.Remove(It.Value());
+				}
+			}
+			It.RemoveCurrent();
+		}
+	}
+}
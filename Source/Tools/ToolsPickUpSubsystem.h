@@ -0,0 +1,67 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ToolsPickUpSubsystem.generated.h"
+
+class UTP_PickUpComponent;
+
+/** Pickups registered in one cell of the spatial hash */
+USTRUCT()
+struct FToolsPickUpCell
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TWeakObjectPtr<UTP_PickUpComponent>> PickUps;
+};
+
+/**
+ * Finds pickups touched by characters without physics overlaps. Pickups are stored in a uniform
+ * spatial hash and every tick only the cells around each AToolsCharacter are tested, so idle
+ * pickups cost nothing. A touched pickup fires OnPickUp once and leaves the hash, like the
+ * overlap path does.
+ */
+UCLASS()
+class TOOLS_API UToolsPickUpSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Adds a pickup to the hash at its current location */
+	void Register(UTP_PickUpComponent* PickUp);
+
+	/** Moves a registered pickup to the cell of its current location */
+	void UpdateLocation(UTP_PickUpComponent* PickUp);
+
+	/** Removes a pickup from the hash */
+	void Unregister(UTP_PickUpComponent* PickUp);
+
+	/** Number of pickups waiting to be picked up */
+	UFUNCTION(BlueprintPure, Category = "PickUp")
+	int32 GetNumPickUps() const { return PickUpCells.Num(); }
+
+	/** Edge length of a hash cell, in world units */
+	float CellSize = 500.0f;
+
+	// UTickableWorldSubsystem interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual void Deinitialize() override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	FIntVector GetCell(const FVector& Location) const;
+
+	TMap<FIntVector, FToolsPickUpCell> Cells;
+
+	/** Cell each registered pickup was stored in */
+	TMap<TWeakObjectPtr<UTP_PickUpComponent>, FIntVector> PickUpCells;
+
+	/** Largest registered pickup radius, widens the cells searched around characters */
+	float MaxPickUpRadius = 0.0f;
+};
@@ -3,6 +3,7 @@
 #include "ToolsProjectile.h"
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "Components/SphereComponent.h"
+#include "ToolsProjectilePool.h"
 
 AToolsProjectile::AToolsProjectile() 
 {
@@ -36,8 +37,57 @@ void AToolsProjectile::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, U
 	// Only add impulse and destroy projectile if we hit a physics
 	if ((OtherActor != nullptr) && (OtherActor != this) && (OtherComp != nullptr) && OtherComp->IsSimulatingPhysics())
 	{
-		OtherComp->AddImpulseAtLocation(GetVelocity() * 100.0f, GetActorLocation());
+		if (!bCosmetic)
+		{
+			OtherComp->AddImpulseAtLocation(GetVelocity() * 100.0f, GetActorLocation());
+		}
 
+		Expire();
+	}
+}
+
+void AToolsProjectile::ActivateFromPool(const FVector& Location, const FRotator& Rotation)
+{
+	bActiveInPool = true;
+
+	SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::ResetPhysics);
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+
+	// A projectile that came to rest has detached itself from its movement component
+	ProjectileMovement->SetUpdatedComponent(CollisionComp);
+	ProjectileMovement->Velocity = Rotation.Vector() * ProjectileMovement->InitialSpeed;
+	ProjectileMovement->Activate(true);
+	ProjectileMovement->UpdateComponentVelocity();
+
+	SetLifeSpan(InitialLifeSpan);
+}
+
+void AToolsProjectile::DeactivateToPool()
+{
+	bActiveInPool = false;
+
+	ProjectileMovement->StopMovementImmediately();
+	ProjectileMovement->Deactivate();
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetLifeSpan(0.0f);
+}
+
+void AToolsProjectile::LifeSpanExpired()
+{
+	Expire();
+}
+
+void AToolsProjectile::Expire()
+{
+	if (UToolsProjectilePool* OwningPool = Pool.Get())
+	{
+		OwningPool->Release(this);
+	}
+	else
+	{
 		Destroy();
 	}
 }
\ No newline at end of file
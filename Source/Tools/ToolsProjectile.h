@@ -8,6 +8,7 @@
 
 class USphereComponent;
 class UProjectileMovementComponent;
+class UToolsProjectilePool;
 
 UCLASS(config=Game)
 class AToolsProjectile : public AActor
@@ -29,9 +30,39 @@ public:
 	UFUNCTION()
 	void OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
 
+	/** Marks the projectile as owned by a pool: it is released instead of destroyed */
+	void SetPool(UToolsProjectilePool* InPool) { Pool = InPool; bActiveInPool = true; }
+
+	/** True while the projectile is flying, false while it waits in its pool */
+	bool IsActiveInPool() const { return bActiveInPool; }
+
+	/** Puts a pooled projectile back in flight from the given transform */
+	void ActivateFromPool(const FVector& Location, const FRotator& Rotation);
+
+	/** Cosmetic projectiles stop on physics bodies without pushing them, the authority applies the hit */
+	void SetCosmetic(bool bInCosmetic) { bCosmetic = bInCosmetic; }
+
+	/** Hides the projectile and stops its movement, collision and lifespan */
+	void DeactivateToPool();
+
 	/** Returns CollisionComp subobject **/
 	USphereComponent* GetCollisionComp() const { return CollisionComp; }
 	/** Returns ProjectileMovement subobject **/
 	UProjectileMovementComponent* GetProjectileMovement() const { return ProjectileMovement; }
+
+protected:
+	/** Lifespan expiry goes back to the pool for pooled projectiles */
+	virtual void LifeSpanExpired() override;
+
+private:
+	/** Releases to the pool, or destroys non-pooled projectiles */
+	void Expire();
+
+	/** Pool this projectile returns to, null for projectiles spawned outside of a pool */
+	TWeakObjectPtr<UToolsProjectilePool> Pool;
+
+	bool bActiveInPool = false;
+
+	bool bCosmetic = false;
 };
 
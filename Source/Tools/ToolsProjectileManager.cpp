@@ -0,0 +1,518 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ToolsProjectileManager.h"
+#include "ToolsProjectile.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/SphereComponent.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/VectorRegister.h"
+#include "Async/ParallelFor.h"
+
+static TAutoConsoleVariable<bool> CVarProjectileAsyncQueries(
+	TEXT("Tools.Projectiles.AsyncQueries"),
+	false,
+	TEXT("Sweep managed projectiles with the async trace API, reading the results back on the next frame."));
+
+static FAutoConsoleCommandWithWorldAndArgs ProjectileBenchmarkCommand(
+	TEXT("Tools.ProjectileBenchmark"),
+	TEXT("Tools.ProjectileBenchmark <Count=1000> <Frames=300>: compares game thread time of sync and async projectile sweeps."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UToolsProjectileManager* Manager = World != nullptr ? World->GetSubsystem<UToolsProjectileManager>() : nullptr;
+		if (Manager == nullptr)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Tools.ProjectileBenchmark: Needs a game or PIE world."));
+			return;
+		}
+
+		const int32 Count = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1000;
+		const int32 Frames = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 300;
+		Manager->StartBenchmark(FMath::Max(Count, 1), FMath::Max(Frames, 1));
+	}));
+
+int32 FManagedProjectileState::Add(const FVector& Position, const FVector& Velocity, double InGravityZ, int32 InArchetype, bool bInCosmetic)
+{
+	PositionX.Add(Position.X);
+	PositionY.Add(Position.Y);
+	PositionZ.Add(Position.Z);
+	VelocityX.Add(Velocity.X);
+	VelocityY.Add(Velocity.Y);
+	VelocityZ.Add(Velocity.Z);
+	GravityZ.Add(InGravityZ);
+	Age.Add(0.0f);
+	bResting.Add(false);
+	bCosmetic.Add(bInCosmetic);
+	return Archetype.Add(InArchetype);
+}
+
+void FManagedProjectileState::RemoveAtSwap(int32 Index)
+{
+	PositionX.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	PositionY.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	PositionZ.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	VelocityX.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	VelocityY.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	VelocityZ.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	GravityZ.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Age.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	bResting.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	bCosmetic.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Archetype.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+void FManagedProjectileState::SetPosition(int32 Index, const FVector& Position)
+{
+	PositionX[Index] = Position.X;
+	PositionY[Index] = Position.Y;
+	PositionZ[Index] = Position.Z;
+}
+
+void FManagedProjectileState::SetVelocity(int32 Index, const FVector& Velocity)
+{
+	VelocityX[Index] = Velocity.X;
+	VelocityY[Index] = Velocity.Y;
+	VelocityZ[Index] = Velocity.Z;
+}
+
+void UToolsProjectileManager::SpawnProjectile(TSubclassOf<AToolsProjectile> ProjectileClass, UStaticMesh* VisualMesh, const FVector& Location, const FRotator& Rotation, bool bCosmetic)
+{
+	if (ProjectileClass == nullptr)
+	{
+		return;
+	}
+
+	const int32 ArchetypeIndex = FindOrAddArchetype(ProjectileClass, VisualMesh);
+	const FManagedProjectileArchetype& Archetype = Archetypes[ArchetypeIndex];
+
+	State.Add(Location, Rotation.Vector() * Archetype.InitialSpeed, Archetype.GravityZ, ArchetypeIndex, bCosmetic);
+}
+
+TStatId UToolsProjectileManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UToolsProjectileManager, STATGROUP_Tickables);
+}
+
+void UToolsProjectileManager::Deinitialize()
+{
+	State = FManagedProjectileState();
+	Visuals.Empty();
+	VisualsActor = nullptr;
+
+	Super::Deinitialize();
+}
+
+bool UToolsProjectileManager::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UToolsProjectileManager::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	if (CVarProjectileAsyncQueries.GetValueOnGameThread())
+	{
+		ConsumeAsyncQueries();
+		RemoveExpired(DeltaTime);
+		IntegrateAll(DeltaTime);
+		SubmitAsyncQueries(DeltaTime);
+	}
+	else
+	{
+		// Projectiles already sit at the end of their step, results of a mode switch can be dropped
+		PendingQueries.Reset();
+
+		RemoveExpired(DeltaTime);
+		IntegrateAll(DeltaTime);
+		SweepSync();
+	}
+
+	UpdateVisuals();
+
+	LastTickSeconds = FPlatformTime::Seconds() - StartTime;
+
+	if (Benchmark.IsSet())
+	{
+		TickBenchmark();
+	}
+}
+
+void UToolsProjectileManager::RemoveExpired(float DeltaTime)
+{
+	for (int32 Index = State.Num() - 1; Index >= 0; --Index)
+	{
+		const float LifeSpan = Archetypes[State.Archetype[Index]].LifeSpan;
+
+		State.Age[Index] += DeltaTime;
+		if (LifeSpan > 0.0f && State.Age[Index] >= LifeSpan)
+		{
+			State.RemoveAtSwap(Index);
+		}
+	}
+}
+
+void UToolsProjectileManager::SweepSync()
+{
+	// Sweeps only read the scene: run the whole batch across worker threads, then resolve the hits here
+	UWorld* World = GetWorld();
+	const int32 Num = State.Num();
+
+	TArray<FHitResult> Hits;
+	TArray<bool> bHits;
+	Hits.SetNum(Num);
+	bHits.SetNumZeroed(Num);
+
+	ParallelFor(Num, [this, World, &Hits, &bHits](int32 Index)
+	{
+		if (State.bResting[Index])
+		{
+			return;
+		}
+
+		const FManagedProjectileArchetype& Archetype = Archetypes[State.Archetype[Index]];
+		const FVector Start = State.GetPosition(Index);
+		const FVector End(EndX[Index], EndY[Index], EndZ[Index]);
+
+		bHits[Index] = World->SweepSingleByProfile(Hits[Index], Start, End, FQuat::Identity, Archetype.CollisionProfile, FCollisionShape::MakeSphere(Archetype.Radius));
+	});
+
+	// Backwards so RemoveAtSwap only moves projectiles that are already resolved
+	for (int32 Index = Num - 1; Index >= 0; --Index)
+	{
+		if (State.bResting[Index])
+		{
+			continue;
+		}
+
+		if (bHits[Index])
+		{
+			const FHitResult& Hit = Hits[Index];
+			State.SetPosition(Index, Hit.Location);
+			if (HandleHit(Index, Hit))
+			{
+				State.RemoveAtSwap(Index);
+			}
+		}
+		else
+		{
+			State.SetPosition(Index, FVector(EndX[Index], EndY[Index], EndZ[Index]));
+		}
+	}
+}
+
+void UToolsProjectileManager::ConsumeAsyncQueries()
+{
+	UWorld* World = GetWorld();
+
+	// Nothing was removed since submission, so indices are still valid. Walking backwards keeps them
+	// valid across the removals below, RemoveAtSwap only moves already processed or newer projectiles.
+	for (int32 QueryIndex = PendingQueries.Num() - 1; QueryIndex >= 0; --QueryIndex)
+	{
+		const FPendingProjectileQuery& Query = PendingQueries[QueryIndex];
+
+		FTraceDatum Datum;
+		if (!World->QueryTraceData(Query.Handle, Datum))
+		{
+			// Result expired, keep the optimistic move
+			continue;
+		}
+
+		const FHitResult* Hit = Datum.OutHits.FindByPredicate([](const FHitResult& Candidate) { return Candidate.bBlockingHit; });
+		if (Hit == nullptr)
+		{
+			continue;
+		}
+
+		// Rewind to the impact, then replay the rest of the step with the bounced velocity
+		State.SetPosition(Query.Index, Hit->Location);
+		if (HandleHit(Query.Index, *Hit))
+		{
+			State.RemoveAtSwap(Query.Index);
+			continue;
+		}
+
+		const float RemainingTime = (1.0f - Hit->Time) * Query.DeltaTime;
+		State.SetPosition(Query.Index, Hit->Location + State.GetVelocity(Query.Index) * RemainingTime);
+	}
+
+	PendingQueries.Reset();
+}
+
+void UToolsProjectileManager::SubmitAsyncQueries(float DeltaTime)
+{
+	UWorld* World = GetWorld();
+	PendingQueries.Reserve(State.Num());
+
+	for (int32 Index = 0; Index < State.Num(); ++Index)
+	{
+		if (State.bResting[Index])
+		{
+			continue;
+		}
+
+		const FManagedProjectileArchetype& Archetype = Archetypes[State.Archetype[Index]];
+		const FVector Start = State.GetPosition(Index);
+		const FVector End(EndX[Index], EndY[Index], EndZ[Index]);
+
+		FPendingProjectileQuery& Query = PendingQueries.AddDefaulted_GetRef();
+		Query.Handle = World->AsyncSweepByProfile(EAsyncTraceType::Single, Start, End, FQuat::Identity, Archetype.CollisionProfile, FCollisionShape::MakeSphere(Archetype.Radius));
+		Query.Index = Index;
+		Query.DeltaTime = DeltaTime;
+
+		State.SetPosition(Index, End);
+	}
+}
+
+void UToolsProjectileManager::StartBenchmark(int32 ProjectileCount, int32 FramesPerMode)
+{
+	Benchmark.Emplace();
+	Benchmark->ProjectileCount = ProjectileCount;
+	Benchmark->FramesPerMode = FramesPerMode;
+
+	BeginBenchmarkMode(false);
+}
+
+void UToolsProjectileManager::BeginBenchmarkMode(bool bAsync)
+{
+	CVarProjectileAsyncQueries->Set(bAsync, ECVF_SetByConsole);
+
+	Benchmark->bAsync = bAsync;
+	Benchmark->FramesDone = 0;
+	Benchmark->ManagerSeconds = 0.0;
+	Benchmark->GameThreadSeconds = 0.0;
+
+	// Same volley for both modes: a fan of projectiles from the player's view, without visuals
+	State = FManagedProjectileState();
+	PendingQueries.Reset();
+
+	FVector Origin = FVector::ZeroVector;
+	FRotator Aim = FRotator::ZeroRotator;
+	if (APlayerController* PlayerController = GetWorld()->GetFirstPlayerController())
+	{
+		PlayerController->GetPlayerViewPoint(Origin, Aim);
+	}
+
+	FRandomStream Random(Benchmark->ProjectileCount);
+	for (int32 Index = 0; Index < Benchmark->ProjectileCount; ++Index)
+	{
+		const FRotator Rotation = Random.VRandCone(Aim.Vector(), FMath::DegreesToRadians(45.0f)).Rotation();
+		const FVector Location = Origin + Random.VRand() * 50.0f;
+		SpawnProjectile(AToolsProjectile::StaticClass(), nullptr, Location, Rotation);
+	}
+}
+
+void UToolsProjectileManager::TickBenchmark()
+{
+	FProjectileBenchmarkRun& Run = *Benchmark;
+	Run.ManagerSeconds += LastTickSeconds;
+	Run.GameThreadSeconds += FPlatformTime::ToSeconds(GGameThreadTime);
+
+	if (++Run.FramesDone < Run.FramesPerMode)
+	{
+		return;
+	}
+
+	if (!Run.bAsync)
+	{
+		Run.SyncManagerSeconds = Run.ManagerSeconds;
+		Run.SyncGameThreadSeconds = Run.GameThreadSeconds;
+		BeginBenchmarkMode(true);
+		return;
+	}
+
+	const double Frames = Run.FramesPerMode;
+	UE_LOG(LogTemp, Display, TEXT("Tools.ProjectileBenchmark: %d projectiles, %d frames per mode"), Run.ProjectileCount, Run.FramesPerMode);
+	UE_LOG(LogTemp, Display, TEXT("Tools.ProjectileBenchmark: Sync  manager %.3f ms, game thread %.3f ms"), Run.SyncManagerSeconds * 1000.0 / Frames, Run.SyncGameThreadSeconds * 1000.0 / Frames);
+	UE_LOG(LogTemp, Display, TEXT("Tools.ProjectileBenchmark: Async manager %.3f ms, game thread %.3f ms"), Run.ManagerSeconds * 1000.0 / Frames, Run.GameThreadSeconds * 1000.0 / Frames);
+
+	CVarProjectileAsyncQueries->Set(false, ECVF_SetByConsole);
+	State = FManagedProjectileState();
+	Benchmark.Reset();
+}
+
+int32 UToolsProjectileManager::FindOrAddArchetype(TSubclassOf<AToolsProjectile> ProjectileClass, UStaticMesh* VisualMesh)
+{
+	const int32 ExistingIndex = Archetypes.IndexOfByPredicate([ProjectileClass, VisualMesh](const FManagedProjectileArchetype& Archetype)
+	{
+		return Archetype.ProjectileClass == ProjectileClass && Archetype.VisualMesh == VisualMesh;
+	});
+
+	if (ExistingIndex != INDEX_NONE)
+	{
+		return ExistingIndex;
+	}
+
+	// Same movement as the actor version of the projectile
+	const AToolsProjectile* Defaults = ProjectileClass->GetDefaultObject<AToolsProjectile>();
+	const UProjectileMovementComponent* Movement = Defaults->GetProjectileMovement();
+
+	FManagedProjectileArchetype Archetype;
+	Archetype.ProjectileClass = ProjectileClass;
+	Archetype.VisualMesh = VisualMesh;
+	Archetype.CollisionProfile = Defaults->GetCollisionComp()->GetCollisionProfileName();
+	Archetype.Radius = Defaults->GetCollisionComp()->GetUnscaledSphereRadius();
+	Archetype.InitialSpeed = Movement->InitialSpeed;
+	Archetype.MaxSpeed = Movement->MaxSpeed;
+	Archetype.GravityZ = GetWorld()->GetGravityZ() * Movement->ProjectileGravityScale;
+	Archetype.Bounciness = Movement->Bounciness;
+	Archetype.Friction = Movement->Friction;
+	Archetype.BounceStopSpeed = Movement->BounceVelocityStopSimulatingThreshold;
+	Archetype.LifeSpan = Defaults->InitialLifeSpan;
+	Archetype.bShouldBounce = Movement->bShouldBounce;
+
+	// Visuals are the only thing spawned, one instanced mesh for every projectile of the archetype
+	UInstancedStaticMeshComponent* Visual = nullptr;
+	if (VisualMesh != nullptr)
+	{
+		if (VisualsActor == nullptr)
+		{
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.ObjectFlags |= RF_Transient;
+			VisualsActor = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+		}
+
+		Visual = NewObject<UInstancedStaticMeshComponent>(VisualsActor);
+		Visual->SetStaticMesh(VisualMesh);
+		Visual->SetMobility(EComponentMobility::Movable);
+		Visual->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Visual->SetCanEverAffectNavigation(false);
+		Visual->RegisterComponent();
+		VisualsActor->AddInstanceComponent(Visual);
+	}
+
+	Visuals.Add(Visual);
+	return Archetypes.Add(Archetype);
+}
+
+void UToolsProjectileManager::IntegrateAll(float DeltaTime)
+{
+	const int32 Num = State.Num();
+	EndX.SetNumUninitialized(Num);
+	EndY.SetNumUninitialized(Num);
+	EndZ.SetNumUninitialized(Num);
+
+	// Velocity Verlet under constant gravity, four projectiles per iteration
+	const VectorRegister4Double Dt = MakeVectorRegisterDouble(double(DeltaTime), double(DeltaTime), double(DeltaTime), double(DeltaTime));
+	const VectorRegister4Double HalfDt = MakeVectorRegisterDouble(0.5 * DeltaTime, 0.5 * DeltaTime, 0.5 * DeltaTime, 0.5 * DeltaTime);
+
+	int32 Index = 0;
+	for (; Index + 4 <= Num; Index += 4)
+	{
+		const VectorRegister4Double VelocityZ = VectorLoad(&State.VelocityZ[Index]);
+		const VectorRegister4Double NewVelocityZ = VectorMultiplyAdd(VectorLoad(&State.GravityZ[Index]), Dt, VelocityZ);
+
+		VectorStore(VectorMultiplyAdd(VectorLoad(&State.VelocityX[Index]), Dt, VectorLoad(&State.PositionX[Index])), &EndX[Index]);
+		VectorStore(VectorMultiplyAdd(VectorLoad(&State.VelocityY[Index]), Dt, VectorLoad(&State.PositionY[Index])), &EndY[Index]);
+		VectorStore(VectorMultiplyAdd(VectorAdd(VelocityZ, NewVelocityZ), HalfDt, VectorLoad(&State.PositionZ[Index])), &EndZ[Index]);
+		VectorStore(NewVelocityZ, &State.VelocityZ[Index]);
+	}
+
+	for (; Index < Num; ++Index)
+	{
+		const double NewVelocityZ = State.VelocityZ[Index] + State.GravityZ[Index] * DeltaTime;
+		EndX[Index] = State.PositionX[Index] + State.VelocityX[Index] * DeltaTime;
+		EndY[Index] = State.PositionY[Index] + State.VelocityY[Index] * DeltaTime;
+		EndZ[Index] = State.PositionZ[Index] + (State.VelocityZ[Index] + NewVelocityZ) * 0.5 * DeltaTime;
+		State.VelocityZ[Index] = NewVelocityZ;
+	}
+}
+
+bool UToolsProjectileManager::HandleHit(int32 Index, const FHitResult& Hit)
+{
+	const FManagedProjectileArchetype& Archetype = Archetypes[State.Archetype[Index]];
+	FVector Velocity = State.GetVelocity(Index);
+
+	// Only add impulse and remove the projectile if we hit a physics body, as AToolsProjectile::OnHit does
+	UPrimitiveComponent* OtherComp = Hit.GetComponent();
+	if (Hit.GetActor() != nullptr && OtherComp != nullptr && OtherComp->IsSimulatingPhysics())
+	{
+		if (!State.bCosmetic[Index])
+		{
+			OtherComp->AddImpulseAtLocation(Velocity * 100.0f, Hit.Location);
+		}
+		return true;
+	}
+
+	if (!Archetype.bShouldBounce)
+	{
+		State.SetVelocity(Index, FVector::ZeroVector);
+		State.GravityZ[Index] = 0.0;
+		State.bResting[Index] = true;
+		return false;
+	}
+
+	// Bounce response of UProjectileMovementComponent::ComputeBounceDelta
+	const double VDotNormal = Velocity | Hit.Normal;
+	if (VDotNormal < 0.0)
+	{
+		const FVector ProjectedNormal = Hit.Normal * -VDotNormal;
+		Velocity += ProjectedNormal;
+		Velocity *= FMath::Clamp(1.0f - Archetype.Friction, 0.0f, 1.0f);
+		Velocity += ProjectedNormal * FMath::Max(Archetype.Bounciness, 0.0f);
+	}
+
+	// A MaxSpeed of 0 means no limit, as in UProjectileMovementComponent::LimitVelocity
+	if (Archetype.MaxSpeed > 0.0f)
+	{
+		Velocity = Velocity.GetClampedToMaxSize(Archetype.MaxSpeed);
+	}
+
+	// Too slow to keep bouncing: rest where it landed
+	if (Velocity.SizeSquared() < FMath::Square(Archetype.BounceStopSpeed))
+	{
+		Velocity = FVector::ZeroVector;
+		State.GravityZ[Index] = 0.0;
+		State.bResting[Index] = true;
+	}
+
+	State.SetVelocity(Index, Velocity);
+	return false;
+}
+
+void UToolsProjectileManager::UpdateVisuals()
+{
+	TArray<TArray<FTransform>> Transforms;
+	Transforms.SetNum(Archetypes.Num());
+
+	for (int32 Index = 0; Index < State.Num(); ++Index)
+	{
+		const int32 ArchetypeIndex = State.Archetype[Index];
+		if (Visuals[ArchetypeIndex] != nullptr)
+		{
+			const FVector Velocity = State.GetVelocity(Index);
+			const FRotator Rotation = Velocity.IsNearlyZero() ? FRotator::ZeroRotator : Velocity.Rotation();
+			Transforms[ArchetypeIndex].Emplace(Rotation, State.GetPosition(Index));
+		}
+	}
+
+	for (int32 ArchetypeIndex = 0; ArchetypeIndex < Visuals.Num(); ++ArchetypeIndex)
+	{
+		UInstancedStaticMeshComponent* Visual = Visuals[ArchetypeIndex];
+		if (Visual == nullptr)
+		{
+			continue;
+		}
+
+		const TArray<FTransform>& ArchetypeTransforms = Transforms[ArchetypeIndex];
+
+		// Match the instance count, then move every instance in one call
+		while (Visual->GetInstanceCount() > ArchetypeTransforms.Num())
+		{
+			Visual->RemoveInstance(Visual->GetInstanceCount() - 1);
+		}
+		if (Visual->GetInstanceCount() < ArchetypeTransforms.Num())
+		{
+			Visual->AddInstances(TArray<FTransform>(ArchetypeTransforms.GetData() + Visual->GetInstanceCount(), ArchetypeTransforms.Num() - Visual->GetInstanceCount()), false, true);
+		}
+
+		if (ArchetypeTransforms.Num() > 0)
+		{
+			Visual->BatchUpdateInstancesTransforms(0, ArchetypeTransforms, true, true, true);
+		}
+	}
+}
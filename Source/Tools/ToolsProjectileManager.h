@@ -0,0 +1,182 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineTypes.h"
+#include "ToolsProjectileManager.generated.h"
+
+class AToolsProjectile;
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+
+/** Movement settings shared by every projectile fired from the same class, read from its default object */
+struct FManagedProjectileArchetype
+{
+	TSubclassOf<AToolsProjectile> ProjectileClass;
+	UStaticMesh* VisualMesh = nullptr;
+	FName CollisionProfile;
+	float Radius = 5.0f;
+	float InitialSpeed = 3000.0f;
+	float MaxSpeed = 3000.0f;
+	float GravityZ = 0.0f;
+	float Bounciness = 0.6f;
+	float Friction = 0.2f;
+	float BounceStopSpeed = 5.0f;
+	float LifeSpan = 3.0f;
+	bool bShouldBounce = true;
+};
+
+/**
+ * Projectile state stored as structure of arrays, one entry per live projectile.
+ * Doubles are kept per component so four projectiles are integrated per vector register.
+ */
+struct FManagedProjectileState
+{
+	TArray<double> PositionX;
+	TArray<double> PositionY;
+	TArray<double> PositionZ;
+	TArray<double> VelocityX;
+	TArray<double> VelocityY;
+	TArray<double> VelocityZ;
+	TArray<double> GravityZ;
+	TArray<float> Age;
+	TArray<int32> Archetype;
+
+	/** Projectiles that came to rest after bouncing, they wait for their lifespan without sweeping */
+	TArray<bool> bResting;
+
+	/** Client copies of server projectiles: hits on physics bodies are left to the server */
+	TArray<bool> bCosmetic;
+
+	int32 Num() const { return Archetype.Num(); }
+	int32 Add(const FVector& Position, const FVector& Velocity, double InGravityZ, int32 InArchetype, bool bInCosmetic);
+	void RemoveAtSwap(int32 Index);
+
+	FVector GetPosition(int32 Index) const { return FVector(PositionX[Index], PositionY[Index], PositionZ[Index]); }
+	FVector GetVelocity(int32 Index) const { return FVector(VelocityX[Index], VelocityY[Index], VelocityZ[Index]); }
+	void SetPosition(int32 Index, const FVector& Position);
+	void SetVelocity(int32 Index, const FVector& Velocity);
+};
+
+/** Sweep submitted through the async trace API, read back on the next frame */
+struct FPendingProjectileQuery
+{
+	FTraceHandle Handle;
+	int32 Index = INDEX_NONE;
+	float DeltaTime = 0.0f;
+};
+
+/** Progress of a Tools.ProjectileBenchmark run */
+struct FProjectileBenchmarkRun
+{
+	int32 ProjectileCount = 0;
+	int32 FramesPerMode = 0;
+	int32 FramesDone = 0;
+	bool bAsync = false;
+	double ManagerSeconds = 0.0;
+	double GameThreadSeconds = 0.0;
+	double SyncManagerSeconds = 0.0;
+	double SyncGameThreadSeconds = 0.0;
+};
+
+/**
+ * Simulates projectiles without one actor per projectile: every live projectile is integrated in a
+ * single vectorized pass, then swept against the world in one batch. Visuals are instances of one
+ * instanced static mesh per projectile class. Hits keep the AToolsProjectile behaviour: bounce off
+ * static geometry, push simulating bodies and disappear.
+ *
+ * With Tools.Projectiles.AsyncQueries the batch goes through the async trace API instead: the
+ * projectile moves ahead optimistically, the sweep runs alongside the rest of the frame, and a hit
+ * read back on the next frame rewinds the projectile to the impact and replays the rest of the step
+ * with the bounced velocity.
+ */
+UCLASS()
+class TOOLS_API UToolsProjectileManager : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Fires a managed projectile with the movement settings of the projectile class.
+	 * Cosmetic projectiles stop on physics bodies without pushing them, the authority applies the hit.
+	 */
+	void SpawnProjectile(TSubclassOf<AToolsProjectile> ProjectileClass, UStaticMesh* VisualMesh, const FVector& Location, const FRotator& Rotation, bool bCosmetic = false);
+
+	/** Number of live managed projectiles */
+	UFUNCTION(BlueprintPure, Category = "Projectile Manager")
+	int32 GetNumProjectiles() const { return State.Num(); }
+
+	/** Game thread time spent by the last tick, in seconds */
+	double GetLastTickSeconds() const { return LastTickSeconds; }
+
+	/**
+	 * Fires ProjectileCount projectiles from the first player, measures FramesPerMode frames with
+	 * synchronous sweeps then the same with async sweeps and logs the average game thread times.
+	 */
+	void StartBenchmark(int32 ProjectileCount, int32 FramesPerMode);
+
+	// UTickableWorldSubsystem interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual void Deinitialize() override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Returns the archetype index of a projectile class, registering it on first use */
+	int32 FindOrAddArchetype(TSubclassOf<AToolsProjectile> ProjectileClass, UStaticMesh* VisualMesh);
+
+	/** Ages every projectile and removes those past their lifespan */
+	void RemoveExpired(float DeltaTime);
+
+	/** Advances velocities and computes the end of this frame's move for every projectile */
+	void IntegrateAll(float DeltaTime);
+
+	/** Sweeps every moving projectile in parallel, then resolves the hits on the game thread */
+	void SweepSync();
+
+	/** Reads back last frame's async sweeps and corrects the projectiles that hit something */
+	void ConsumeAsyncQueries();
+
+	/** Submits this frame's sweeps and moves the projectiles to the end of their step */
+	void SubmitAsyncQueries(float DeltaTime);
+
+	/** Spawns the benchmark projectiles and switches query mode */
+	void BeginBenchmarkMode(bool bAsync);
+
+	/** Accumulates benchmark timings, moving on to the next mode or logging the results */
+	void TickBenchmark();
+
+	/** Applies a blocking hit to a projectile. Returns true if the projectile must be removed. */
+	bool HandleHit(int32 Index, const FHitResult& Hit);
+
+	/** Moves the instanced visuals to the new projectile transforms */
+	void UpdateVisuals();
+
+	FManagedProjectileState State;
+
+	/** End of this frame's move, filled by IntegrateAll */
+	TArray<double> EndX;
+	TArray<double> EndY;
+	TArray<double> EndZ;
+
+	TArray<FManagedProjectileArchetype> Archetypes;
+
+	/** Sweeps submitted last frame, in increasing projectile index */
+	TArray<FPendingProjectileQuery> PendingQueries;
+
+	double LastTickSeconds = 0.0;
+
+	TOptional<FProjectileBenchmarkRun> Benchmark;
+
+	/** One instanced mesh per archetype, null for archetypes without visual */
+	UPROPERTY()
+	TArray<TObjectPtr<UInstancedStaticMeshComponent>> Visuals;
+
+	/** Actor owning the instanced meshes */
+	UPROPERTY()
+	TObjectPtr<AActor> VisualsActor;
+};
@@ -0,0 +1,95 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ToolsProjectilePool.h"
+#include "ToolsProjectile.h"
+#include "Engine/World.h"
+
+void UToolsProjectilePool::Prewarm(TSubclassOf<AToolsProjectile> ProjectileClass, int32 Count)
+{
+	if (ProjectileClass == nullptr)
+	{
+		return;
+	}
+
+	FToolsProjectileList& List = InactiveProjectiles.FindOrAdd(ProjectileClass);
+	while (List.Projectiles.Num() < Count)
+	{
+		// Spawned out of the way, then parked right away
+		AToolsProjectile* Projectile = SpawnPooledProjectile(ProjectileClass, FVector::ZeroVector, FRotator::ZeroRotator, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		if (Projectile == nullptr)
+		{
+			break;
+		}
+
+		Release(Projectile);
+	}
+}
+
+AToolsProjectile* UToolsProjectilePool::Acquire(TSubclassOf<AToolsProjectile> ProjectileClass, const FVector& Location, const FRotator& Rotation, bool bCosmetic)
+{
+	if (ProjectileClass == nullptr)
+	{
+		return nullptr;
+	}
+
+	FToolsProjectileList& List = InactiveProjectiles.FindOrAdd(ProjectileClass);
+	while (List.Projectiles.Num() > 0)
+	{
+		AToolsProjectile* Projectile = List.Projectiles.Pop(EAllowShrinking::No);
+		if (!IsValid(Projectile))
+		{
+			continue;
+		}
+
+		// Same rule as AdjustIfPossibleButDontSpawnIfColliding: nudge out of geometry or give up the shot.
+		// The encroachment test skips actors with collision off, which parked projectiles have.
+		FVector SpawnLocation = Location;
+		FRotator SpawnRotation = Rotation;
+		Projectile->SetActorEnableCollision(true);
+		if (!GetWorld()->FindTeleportSpot(Projectile, SpawnLocation, SpawnRotation))
+		{
+			Projectile->SetActorEnableCollision(false);
+			List.Projectiles.Push(Projectile);
+			return nullptr;
+		}
+
+		++PoolHits;
+		Projectile->SetCosmetic(bCosmetic);
+		Projectile->ActivateFromPool(SpawnLocation, SpawnRotation);
+		return Projectile;
+	}
+
+	++PoolMisses;
+	AToolsProjectile* Projectile = SpawnPooledProjectile(ProjectileClass, Location, Rotation, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButDontSpawnIfColliding);
+	if (Projectile != nullptr)
+	{
+		Projectile->SetCosmetic(bCosmetic);
+	}
+
+	return Projectile;
+}
+
+void UToolsProjectilePool::Release(AToolsProjectile* Projectile)
+{
+	if (!IsValid(Projectile) || !Projectile->IsActiveInPool())
+	{
+		return;
+	}
+
+	Projectile->DeactivateToPool();
+	InactiveProjectiles.FindOrAdd(Projectile->GetClass()).Projectiles.Push(Projectile);
+}
+
+AToolsProjectile* UToolsProjectilePool::SpawnPooledProjectile(TSubclassOf<AToolsProjectile> ProjectileClass, const FVector& Location, const FRotator& Rotation, ESpawnActorCollisionHandlingMethod CollisionHandling)
+{
+	FActorSpawnParameters ActorSpawnParams;
+	ActorSpawnParams.SpawnCollisionHandlingOverride = CollisionHandling;
+
+	AToolsProjectile* Projectile = GetWorld()->SpawnActor<AToolsProjectile>(ProjectileClass, Location, Rotation, ActorSpawnParams);
+	if (Projectile != nullptr)
+	{
+		Projectile->SetPool(this);
+	}
+
+	return Projectile;
+}
@@ -0,0 +1,57 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ToolsProjectilePool.generated.h"
+
+class AToolsProjectile;
+
+/** Inactive projectiles of one class */
+USTRUCT()
+struct FToolsProjectileList
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<AToolsProjectile>> Projectiles;
+};
+
+/**
+ * Keeps fired projectiles alive once they hit or expire, and hands them back out on the next shot
+ * instead of spawning a new actor.
+ */
+UCLASS()
+class TOOLS_API UToolsProjectilePool : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Spawns inactive projectiles until Count of them are available for the class */
+	void Prewarm(TSubclassOf<AToolsProjectile> ProjectileClass, int32 Count);
+
+	/** Returns an active projectile at the given transform, reusing an inactive one when available. Null if the spot is blocked. */
+	AToolsProjectile* Acquire(TSubclassOf<AToolsProjectile> ProjectileClass, const FVector& Location, const FRotator& Rotation, bool bCosmetic = false);
+
+	/** Deactivates the projectile and makes it available again */
+	void Release(AToolsProjectile* Projectile);
+
+	/** Shots served by an inactive projectile */
+	UFUNCTION(BlueprintPure, Category = "Projectile Pool")
+	int32 GetPoolHits() const { return PoolHits; }
+
+	/** Shots that had to spawn a new projectile */
+	UFUNCTION(BlueprintPure, Category = "Projectile Pool")
+	int32 GetPoolMisses() const { return PoolMisses; }
+
+private:
+	/** Spawns a projectile owned by the pool */
+	AToolsProjectile* SpawnPooledProjectile(TSubclassOf<AToolsProjectile> ProjectileClass, const FVector& Location, const FRotator& Rotation, ESpawnActorCollisionHandlingMethod CollisionHandling);
+
+	UPROPERTY()
+	TMap<TObjectPtr<UClass>, FToolsProjectileList> InactiveProjectiles;
+
+	int32 PoolHits = 0;
+	int32 PoolMisses = 0;
+};
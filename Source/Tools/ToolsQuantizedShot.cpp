@@ -0,0 +1,134 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ToolsQuantizedShot.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/NetSerialization.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/CoreNet.h"
+
+FToolsQuantizedShot FToolsQuantizedShot::Make(const FVector& InOrigin, const FRotator& Aim, uint16 InSeed)
+{
+	FToolsQuantizedShot Shot;
+	Shot.Origin = FVector(FMath::RoundToDouble(InOrigin.X * 10.0) / 10.0, FMath::RoundToDouble(InOrigin.Y * 10.0) / 10.0, FMath::RoundToDouble(InOrigin.Z * 10.0) / 10.0);
+	Shot.Pitch = FRotator::CompressAxisToShort(Aim.Pitch);
+	Shot.Yaw = FRotator::CompressAxisToShort(Aim.Yaw);
+	Shot.Seed = InSeed;
+	return Shot;
+}
+
+FVector FToolsQuantizedShot::GetOrigin() const
+{
+	return Origin;
+}
+
+FRotator FToolsQuantizedShot::GetRotation(float SpreadDegrees) const
+{
+	const FRotator Aim(FRotator::DecompressAxisFromShort(Pitch), FRotator::DecompressAxisFromShort(Yaw), 0.0f);
+	if (SpreadDegrees <= 0.0f)
+	{
+		return Aim;
+	}
+
+	const FRandomStream Random(Seed);
+	return Random.VRandCone(Aim.Vector(), FMath::DegreesToRadians(SpreadDegrees)).Rotation();
+}
+
+bool FToolsQuantizedShot::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	// Same packing as FVector_NetQuantize10
+	bOutSuccess = SerializePackedVector<10, 24>(Origin, Ar);
+	Ar << Pitch;
+	Ar << Yaw;
+	Ar << Seed;
+	return true;
+}
+
+namespace ToolsNetShotPrivate
+{
+	struct FModeStats
+	{
+		int32 Shots = 0;
+		uint64 StartOutBytes = 0;
+		uint64 LastOutBytes = 0;
+		int32 PeakActorChannels = 0;
+	};
+
+	FModeStats ModeStats[3];
+
+	int32 CountActorChannels(UNetDriver* NetDriver)
+	{
+		int32 Channels = 0;
+		for (UNetConnection* Connection : NetDriver->ClientConnections)
+		{
+			Channels += Connection != nullptr ? Connection->ActorChannelsNum() : 0;
+		}
+		return Channels;
+	}
+
+	int32 GetFireEventBits()
+	{
+		FToolsQuantizedShot Shot = FToolsQuantizedShot::Make(FVector(12345.6, -2345.6, 345.6), FRotator(-10.0f, 120.0f, 0.0f), 42);
+		FNetBitWriter Writer(nullptr, 256);
+		bool bSuccess = false;
+		Shot.NetSerialize(Writer, nullptr, bSuccess);
+		return int32(Writer.GetNumBits());
+	}
+}
+
+void FToolsNetShotStats::RecordShot(UWorld* World, EToolsWeaponReplication Mode)
+{
+	UNetDriver* NetDriver = World != nullptr ? World->GetNetDriver() : nullptr;
+	if (NetDriver == nullptr || Mode == EToolsWeaponReplication::None)
+	{
+		return;
+	}
+
+	ToolsNetShotPrivate::FModeStats& Stats = ToolsNetShotPrivate::ModeStats[uint8(Mode)];
+	if (Stats.Shots == 0)
+	{
+		Stats.StartOutBytes = NetDriver->OutTotalBytes;
+	}
+
+	++Stats.Shots;
+	Stats.LastOutBytes = NetDriver->OutTotalBytes;
+	Stats.PeakActorChannels = FMath::Max(Stats.PeakActorChannels, ToolsNetShotPrivate::CountActorChannels(NetDriver));
+}
+
+static FAutoConsoleCommandWithWorldAndArgs NetShotStatsCommand(
+	TEXT("Tools.NetShotStats"),
+	TEXT("Tools.NetShotStats [reset]: logs server bytes per shot and actor channels for each weapon replication mode."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		using namespace ToolsNetShotPrivate;
+
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			for (FModeStats& Stats : ModeStats)
+			{
+				Stats = FModeStats();
+			}
+			return;
+		}
+
+		UNetDriver* NetDriver = World != nullptr ? World->GetNetDriver() : nullptr;
+		const int32 ActorChannels = NetDriver != nullptr ? CountActorChannels(NetDriver) : 0;
+
+		UE_LOG(LogTemp, Display, TEXT("Tools.NetShotStats: Fire event payload %d bits, %d open actor channels now"), GetFireEventBits(), ActorChannels);
+
+		const TCHAR* ModeNames[] = { TEXT("None"), TEXT("ActorReplication"), TEXT("FireEvent") };
+		for (int32 Mode = 1; Mode < UE_ARRAY_COUNT(ModeStats); ++Mode)
+		{
+			const FModeStats& Stats = ModeStats[Mode];
+			if (Stats.Shots == 0)
+			{
+				continue;
+			}
+
+			// Driver totals include every other replicated property, compare modes under the same conditions
+			const double BytesPerShot = double(Stats.LastOutBytes - Stats.StartOutBytes) / Stats.Shots;
+			UE_LOG(LogTemp, Display, TEXT("Tools.NetShotStats: %s: %d shots, %.1f server bytes sent per shot, peak %d actor channels"),
+				ModeNames[Mode], Stats.Shots, BytesPerShot, Stats.PeakActorChannels);
+		}
+	}));
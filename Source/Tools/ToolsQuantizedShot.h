@@ -0,0 +1,69 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ToolsQuantizedShot.generated.h"
+
+/** How a weapon's shots reach the other machines of a network game */
+UENUM(BlueprintType)
+enum class EToolsWeaponReplication : uint8
+{
+	/** Projectiles only exist on the machine that fired */
+	None,
+
+	/** The server spawns a replicated projectile actor per shot */
+	ActorReplication,
+
+	/** A quantized fire event is multicast and every machine simulates the projectile itself */
+	FireEvent
+};
+
+/**
+ * Everything needed to replay a shot: muzzle location rounded to 0.1 unit, aim as two 16 bit
+ * angles and a seed driving the spread. Tools.NetShotStats reports the measured size.
+ */
+USTRUCT()
+struct TOOLS_API FToolsQuantizedShot
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector Origin = FVector::ZeroVector;
+
+	UPROPERTY()
+	uint16 Pitch = 0;
+
+	UPROPERTY()
+	uint16 Yaw = 0;
+
+	UPROPERTY()
+	uint16 Seed = 0;
+
+	/** Quantizes a shot, the firing machine should replay the result rather than its inputs */
+	static FToolsQuantizedShot Make(const FVector& InOrigin, const FRotator& Aim, uint16 InSeed);
+
+	/** Origin as every machine decodes it */
+	FVector GetOrigin() const;
+
+	/** Firing direction with the seeded spread applied, identical on every machine */
+	FRotator GetRotation(float SpreadDegrees) const;
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FToolsQuantizedShot> : public TStructOpsTypeTraitsBase2<FToolsQuantizedShot>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+/** Counters behind the Tools.NetShotStats console command */
+struct TOOLS_API FToolsNetShotStats
+{
+	/** Records a shot sent by the server in the given mode */
+	static void RecordShot(UWorld* World, EToolsWeaponReplication Mode);
+};